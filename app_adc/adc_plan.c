@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "adc_plan.h"
+#include "driver_clock.h"
+#include "driver_sim.h"
+#include "driver_trgmux.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ADC_PLAN_NS_PER_SECOND      1000000000ULL
+
+/* LPIT_DRV_SetTimerPeriod() needs more than 2 counts */
+#define ADC_PLAN_MIN_PERIOD         3U
+
+/* ADCK cycles per conversion beyond the sample phase, rounded up from the RM timing table */
+#define ADC_PLAN_OVERHEAD_CLOCKS    5U      /* trigger arbitration and result transfer */
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Conversion phase in ADCK cycles, indexed by adc_resolution_t */
+static const uint8_t ADC_PLAN_CONVERT_CLOCKS[] = {
+    [ADC_Resolution8Bit]  = 20U,
+    [ADC_Resolution12Bit] = 28U,
+    [ADC_Resolution10Bit] = 24U,
+};
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+/* Clocks and scan length, the parts of a plan that do not depend on the rate */
+static adc_plan_status_t adc_plan_clocks(const adc_plan_request_t* request, adc_plan_t* plan)
+{
+    uint32_t average;
+
+    if ((request->groupCount == 0U) || (request->groupCount > ADC_PLAN_MAX_GROUPS))
+    {
+        return ADC_PLAN_BAD_GROUPS;
+    }
+
+    /* ALTCLK1 is the PCC functional clock, the other inputs are not driven here */
+    plan->lpitClockHz = CLOCK_DRV_GetIpFreq(CLOCK_LPIT);
+    plan->adcClockHz  = (request->adc->clockSource == ADC_ClockSourceAlt0) ?
+                        (CLOCK_DRV_GetIpFreq(CLOCK_ADC0) >> request->adc->clockDivider) : 0U;
+    if ((plan->lpitClockHz == 0U) ||
+        (plan->adcClockHz < ADC_PLAN_ADCK_MIN_HZ) || (plan->adcClockHz > ADC_PLAN_ADCK_MAX_HZ))
+    {
+        return ADC_PLAN_BAD_CLOCK;
+    }
+
+    /* Averaging repeats every conversion 4 to 32 times */
+    average = (request->adc->hardwareAverage == ADC_HardwareAverageDisabled) ?
+              1U : (2U << request->adc->hardwareAverage);
+    plan->scanClocks = request->groupCount * average *
+                       (request->adc->sampleClockCount +
+                        ADC_PLAN_CONVERT_CLOCKS[request->adc->resolution] +
+                        ADC_PLAN_OVERHEAD_CLOCKS);
+    plan->scanNs     = (uint32_t)(((uint64_t)plan->scanClocks * ADC_PLAN_NS_PER_SECOND) /
+                                  plan->adcClockHz);
+
+    return ADC_PLAN_OK;
+}
+
+/* LPIT counts one scan takes, rounded up */
+static uint32_t adc_plan_min_period(const adc_plan_t* plan)
+{
+    uint64_t counts = (((uint64_t)plan->scanClocks * plan->lpitClockHz) + plan->adcClockHz - 1U) /
+                      plan->adcClockHz;
+
+    return (counts < ADC_PLAN_MIN_PERIOD) ? ADC_PLAN_MIN_PERIOD : (uint32_t)counts;
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+adc_plan_status_t adc_plan_compute(const adc_plan_request_t* request, adc_plan_t* plan)
+{
+    adc_plan_status_t status = adc_plan_clocks(request, plan);
+
+    if (status != ADC_PLAN_OK)
+    {
+        return status;
+    }
+    if (request->sampleRateHz == 0U)
+    {
+        return ADC_PLAN_RATE_TOO_LOW;
+    }
+
+    /* Nearest period, the achieved rate is reported back */
+    plan->period       = (plan->lpitClockHz + (request->sampleRateHz / 2U)) / request->sampleRateHz;
+    if (plan->period < adc_plan_min_period(plan))
+    {
+        return ADC_PLAN_RATE_TOO_HIGH;
+    }
+    plan->sampleRateHz = plan->lpitClockHz / plan->period;
+
+    return ADC_PLAN_OK;
+}
+
+uint32_t adc_plan_max_rate(const adc_plan_request_t* request)
+{
+    adc_plan_t plan;
+
+    if (adc_plan_clocks(request, &plan) != ADC_PLAN_OK)
+    {
+        return 0U;
+    }
+
+    return plan.lpitClockHz / adc_plan_min_period(&plan);
+}
+
+adc_plan_status_t adc_plan_apply(const adc_plan_request_t* request, adc_plan_t* plan)
+{
+    sim_adc0_opt_t option =
+    {
+        .ADC_Trigger_source    = SIM_ADC_TriggerSource_TRGMUX,
+        .ADC_PreTrigger_source = SIM_ADC_PreTriggerSource_TRGMUX,
+    };
+    adc_plan_status_t status = adc_plan_compute(request, plan);
+    uint32_t group;
+
+    if (status != ADC_PLAN_OK)
+    {
+        return status;
+    }
+
+    LPIT_DRV_StopTimer(request->lpit, request->lpitChannel);
+    /* ADC0 triggers and pre-triggers come from TRGMUX */
+    SIM_DRV_ADC0option(&option);
+    /* One timeout pre-triggers every group of the scan, the others are disconnected */
+    for (group = 0U; group < ADC_PLAN_MAX_GROUPS; group++)
+    {
+        TRGMUX_DRV_SetTriggerSource(TRGMUX, TRGMUX_ADC0_INDEX, (trgmux_trigger_input_t)group,
+                                    (group < request->groupCount) ?
+                                    (trgmux_trigger_source_t)(TRGMUX_Source_LPIT_CH0 + request->lpitChannel) :
+                                    TRGMUX_Source_Disabled);
+    }
+    LPIT_DRV_SetTimerPeriod(request->lpit, request->lpitChannel, plan->period);
+    LPIT_DRV_StartTimer(request->lpit, request->lpitChannel);
+
+    return ADC_PLAN_OK;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,75 @@
+#ifndef APP_ADC_ADC_PLAN_H_
+#define APP_ADC_ADC_PLAN_H_
+
+#include "driver_common.h"
+#include "driver_adc.h"
+#include "driver_lpit.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* ADC0 pre-triggers reachable from TRGMUX */
+#define ADC_PLAN_MAX_GROUPS     4U
+
+/* Converter clock range of the datasheet */
+#define ADC_PLAN_ADCK_MIN_HZ    2000000U
+#define ADC_PLAN_ADCK_MAX_HZ    50000000U
+
+typedef enum {
+    ADC_PLAN_OK = 0,
+    ADC_PLAN_BAD_GROUPS,        /* no group, or more than TRGMUX can pre-trigger */
+    ADC_PLAN_BAD_CLOCK,         /* functional clock off or unknown, or ADCK out of range */
+    ADC_PLAN_RATE_TOO_LOW,      /* zero rate */
+    ADC_PLAN_RATE_TOO_HIGH,     /* the scan does not fit in one LPIT period */
+} adc_plan_status_t;
+
+/* An LPIT channel triggering a scan of channel groups 0 to groupCount - 1 */
+typedef struct {
+    uint32_t            sampleRateHz;   /* scans per second */
+    const adc_config_t* adc;            /* converter settings the scan time depends on */
+    uint8_t             groupCount;     /* groups pre-triggered together by each timeout */
+    LPIT_Type*          lpit;
+    lpit_chnl_t         lpitChannel;
+} adc_plan_request_t;
+
+/* Timing derived from the clocks actually programmed */
+typedef struct {
+    uint32_t lpitClockHz;       /* LPIT functional clock */
+    uint32_t adcClockHz;        /* ADCK, after the ADC divider */
+    uint32_t period;            /* LPIT counts per scan */
+    uint32_t sampleRateHz;      /* achieved rate, lpitClockHz / period */
+    uint32_t scanClocks;        /* ADCK cycles to convert one scan, averaging included */
+    uint32_t scanNs;            /* the same in nanoseconds */
+} adc_plan_t;
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         work out the timing of a request without touching the trigger chain
+
+  The LPIT and ADC clocks must already be configured, they are read back from PCC and SCG.
+  \param [in]    request : rate, converter settings and groups
+  \param [out]   plan : timing, complete when ADC_PLAN_OK is returned
+  \return        ADC_PLAN_OK if the scan fits the period
+ */
+adc_plan_status_t adc_plan_compute(const adc_plan_request_t* request, adc_plan_t* plan);
+
+/**
+  \brief         highest rate whose scan still fits one LPIT period
+  \param [in]    request : converter settings and groups, the rate is ignored
+  \return        scans per second, 0 if the request cannot be planned at any rate
+ */
+uint32_t adc_plan_max_rate(const adc_plan_request_t* request);
+
+/**
+  \brief         plan a request and program SIM, TRGMUX and the LPIT channel together
+
+  Nothing is programmed unless the plan is valid. The LPIT channel is started last, the
+  ADC and whatever collects its results must be ready.
+  \param [in]    request : rate, converter settings and groups
+  \param [out]   plan : timing, complete when ADC_PLAN_OK is returned
+  \return        status of adc_plan_compute()
+ */
+adc_plan_status_t adc_plan_apply(const adc_plan_request_t* request, adc_plan_t* plan);
+
+#endif /* APP_ADC_ADC_PLAN_H_ */
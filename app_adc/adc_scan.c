@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "adc_scan.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Above any 12-bit result, marks a frame the DMA has not written yet */
+#define ADC_SCAN_NO_SAMPLE      0xFFFFFFFFUL
+#define ADC_SCAN_NO_BLOCK       0xFFU
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static adc_scan_frame_t ADC_SCAN_RING[ADC_SCAN_FRAME_COUNT] __attribute__((aligned(ADC_SCAN_RING_BYTES)));
+
+static DMA_Type*         adc_scan_dma           = NULL;
+static uint8_t           adc_scan_channel       = 0;
+static uint8_t           adc_scan_block_channel = 0;
+static adc_scan_notify_t adc_scan_notify        = NULL;
+static uint8_t           adc_scan_ready         = ADC_SCAN_NO_BLOCK;
+static volatile uint32_t adc_scan_overruns      = 0;
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void adc_scan_init(DMA_Type* dma, uint8_t channel, uint8_t blockChannel, adc_scan_notify_t notify)
+{
+    uint32_t index;
+    uint32_t group;
+
+    adc_scan_dma           = dma;
+    adc_scan_channel       = channel;
+    adc_scan_block_channel = blockChannel;
+    adc_scan_notify        = notify;
+    for (index = 0; index < ADC_SCAN_FRAME_COUNT; index++)
+    {
+        for (group = 0; group < ADC_SCAN_CHANNEL_COUNT; group++)
+        {
+            ADC_SCAN_RING[index].samples[group] = ADC_SCAN_NO_SAMPLE;
+        }
+    }
+}
+
+adc_scan_frame_t* adc_scan_ring()
+{
+    return ADC_SCAN_RING;
+}
+
+bool adc_scan_latest(adc_scan_frame_t* frame)
+{
+    uint32_t offset = DMA_DRV_GetDestAddress(adc_scan_dma, adc_scan_channel) - (uint32_t)ADC_SCAN_RING;
+    /* The DMA is writing the frame at offset, or about to start it, the one before is complete */
+    uint32_t index  = ((offset / sizeof(adc_scan_frame_t)) + ADC_SCAN_FRAME_COUNT - 1U) &
+                      (ADC_SCAN_FRAME_COUNT - 1U);
+
+    /* Overwriting it takes the rest of the ring, the copy is done long before */
+    *frame = ADC_SCAN_RING[index];
+
+    return (frame->samples[ADC_SCAN_CHANNEL_COUNT - 1U] != ADC_SCAN_NO_SAMPLE);
+}
+
+void adc_scan_irq_handler()
+{
+    /* Counts down from ADC_SCAN_FRAME_COUNT, one per frame, and reloads at the end of block 1 */
+    uint16_t left = DMA_DRV_GetCurrentMajorCount(adc_scan_dma, adc_scan_block_channel);
+    uint8_t  half = (left > ADC_SCAN_BLOCK_FRAMES) ? 1U : 0U;
+
+    DMA_DRV_ClearChannelInterrupt(adc_scan_dma, adc_scan_block_channel);
+    DMA_DRV_ClearChannelDone(adc_scan_dma, adc_scan_block_channel);
+
+    if (__atomic_exchange_n(&adc_scan_ready, half, __ATOMIC_RELAXED) != ADC_SCAN_NO_BLOCK)
+    {
+        adc_scan_overruns++;
+    }
+    adc_scan_notify();
+}
+
+const adc_scan_frame_t* adc_scan_get_block()
+{
+    /* Taken in one exchange, a block signalled meanwhile is not lost */
+    uint8_t half = __atomic_exchange_n(&adc_scan_ready, ADC_SCAN_NO_BLOCK, __ATOMIC_RELAXED);
+
+    return (half == ADC_SCAN_NO_BLOCK) ? NULL : &ADC_SCAN_RING[half * ADC_SCAN_BLOCK_FRAMES];
+}
+
+uint32_t adc_scan_get_overruns()
+{
+    return adc_scan_overruns;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
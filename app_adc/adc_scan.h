@@ -0,0 +1,87 @@
+#ifndef APP_ADC_ADC_SCAN_H_
+#define APP_ADC_ADC_SCAN_H_
+
+#include "driver_common.h"
+#include "driver_dma.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Channel groups converted per trigger, at most the 4 TRGMUX pre-triggers of ADC0 */
+#ifndef ADC_SCAN_CHANNEL_COUNT
+#define ADC_SCAN_CHANNEL_COUNT  2U
+#endif
+
+/* Frames per block, the ring holds two blocks filled in turn */
+#ifndef ADC_SCAN_BLOCK_FRAMES
+#define ADC_SCAN_BLOCK_FRAMES   32U
+#endif
+
+#define ADC_SCAN_FRAME_COUNT    (2U * ADC_SCAN_BLOCK_FRAMES)
+
+/* The DMA wraps the ring with its destination modulo, so the size is a power of two */
+#define ADC_SCAN_RING_BYTES     (ADC_SCAN_FRAME_COUNT * ADC_SCAN_CHANNEL_COUNT * 4U)
+
+#if (ADC_SCAN_CHANNEL_COUNT == 0) || (ADC_SCAN_CHANNEL_COUNT > 4)
+#error "ADC_SCAN_CHANNEL_COUNT must be 1 to 4"
+#endif
+#if (ADC_SCAN_RING_BYTES & (ADC_SCAN_RING_BYTES - 1U)) != 0
+#error "ADC_SCAN_CHANNEL_COUNT * ADC_SCAN_BLOCK_FRAMES must be a power of two"
+#endif
+
+/* Results of one scan, samples[n] from channel group n */
+typedef struct {
+    uint32_t samples[ADC_SCAN_CHANNEL_COUNT];
+} adc_scan_frame_t;
+
+/**
+  \brief     a block is ready for adc_scan_get_block(), called from interrupt context
+ */
+typedef void (*adc_scan_notify_t)(void);
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         set up the ring, before the DMA channels are started
+  \param [in]    dma : DMA instance filling the ring
+  \param [in]    channel : DMA channel filling the ring, one major loop per frame
+  \param [in]    blockChannel : DMA channel linked at the end of every frame, with a
+                  major loop of ADC_SCAN_FRAME_COUNT and the half and major interrupts
+  \param [in]    notify : called when a block is ready
+ */
+void adc_scan_init(DMA_Type* dma, uint8_t channel, uint8_t blockChannel, adc_scan_notify_t notify);
+
+/**
+  \brief     interrupt handler of the block channel
+ */
+void adc_scan_irq_handler();
+
+/**
+  \brief         take the block filled last
+
+  The DMA fills the other block meanwhile. The block must be consumed within one
+  block period, before the DMA comes back to it.
+  \return        ADC_SCAN_BLOCK_FRAMES frames, NULL if no block is ready
+ */
+const adc_scan_frame_t* adc_scan_get_block();
+
+/**
+  \brief     number of blocks replaced before they were taken
+ */
+uint32_t adc_scan_get_overruns();
+
+/**
+  \brief         ring the DMA writes the frames to, aligned to ADC_SCAN_RING_BYTES
+ */
+adc_scan_frame_t* adc_scan_ring();
+
+/**
+  \brief         copy the most recent complete frame
+
+  The frame is located from the DMA destination address, no interrupt is involved.
+  \param [out]   frame : where to copy the frame
+  \return        false until the first scan has completed
+ */
+bool adc_scan_latest(adc_scan_frame_t* frame);
+
+#endif /* APP_ADC_ADC_SCAN_H_ */
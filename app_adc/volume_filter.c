@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "volume_filter.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define VOLUME_FILTER_LUT_SIZE      (VOLUME_FILTER_INPUT_MAX + 1U)
+#define VOLUME_FILTER_AVERAGE_SHIFT ((uint32_t)__builtin_ctz(VOLUME_FILTER_AVERAGE_TAPS))
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Volume of every input count, so the quantizer does no multiply or divide */
+static uint8_t  VOLUME_LUT[VOLUME_FILTER_LUT_SIZE];
+
+static bool     volume_primed   = false;
+static uint8_t  volume_current  = 0;
+static uint16_t volume_smoothed = 0;
+
+#if VOLUME_FILTER_MEDIAN_TAPS > 1U
+static uint16_t median_window[VOLUME_FILTER_MEDIAN_TAPS];
+static uint8_t  median_next = 0;
+#endif
+
+#if VOLUME_FILTER_MODE == VOLUME_FILTER_IIR
+static uint32_t iir_state = 0;      /* smoothed value scaled by 2^VOLUME_FILTER_IIR_SHIFT */
+#else
+static uint16_t average_window[VOLUME_FILTER_AVERAGE_TAPS];
+static uint32_t average_sum  = 0;
+static uint8_t  average_next = 0;
+#endif
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void volume_filter_prime(uint16_t sample)
+{
+    uint32_t index;
+
+#if VOLUME_FILTER_MEDIAN_TAPS > 1U
+    for (index = 0; index < VOLUME_FILTER_MEDIAN_TAPS; index++)
+    {
+        median_window[index] = sample;
+    }
+#endif
+#if VOLUME_FILTER_MODE == VOLUME_FILTER_IIR
+    iir_state = (uint32_t)sample << VOLUME_FILTER_IIR_SHIFT;
+#else
+    for (index = 0; index < VOLUME_FILTER_AVERAGE_TAPS; index++)
+    {
+        average_window[index] = sample;
+    }
+    average_sum = (uint32_t)sample << VOLUME_FILTER_AVERAGE_SHIFT;
+#endif
+    (void)index;
+}
+
+/* Rejects single-sample glitches before they reach the smoothing stage */
+static uint16_t volume_filter_median(uint16_t sample)
+{
+#if VOLUME_FILTER_MEDIAN_TAPS > 1U
+    uint16_t sorted[VOLUME_FILTER_MEDIAN_TAPS];
+    uint16_t value;
+    uint32_t i;
+    uint32_t j;
+
+    median_window[median_next] = sample;
+    median_next = (median_next + 1U == VOLUME_FILTER_MEDIAN_TAPS) ? 0U : (median_next + 1U);
+
+    /* Insertion sort, a handful of taps */
+    for (i = 0; i < VOLUME_FILTER_MEDIAN_TAPS; i++)
+    {
+        value = median_window[i];
+        for (j = i; (j > 0U) && (sorted[j - 1U] > value); j--)
+        {
+            sorted[j] = sorted[j - 1U];
+        }
+        sorted[j] = value;
+    }
+
+    return sorted[VOLUME_FILTER_MEDIAN_TAPS / 2U];
+#else
+    return sample;
+#endif
+}
+
+static uint16_t volume_filter_smooth(uint16_t sample)
+{
+#if VOLUME_FILTER_MODE == VOLUME_FILTER_IIR
+    iir_state = iir_state - (iir_state >> VOLUME_FILTER_IIR_SHIFT) + sample;
+
+    return (uint16_t)(iir_state >> VOLUME_FILTER_IIR_SHIFT);
+#else
+    average_sum += sample;
+    average_sum -= average_window[average_next];
+    average_window[average_next] = sample;
+    average_next = (average_next + 1U) & (VOLUME_FILTER_AVERAGE_TAPS - 1U);
+
+    return (uint16_t)(average_sum >> VOLUME_FILTER_AVERAGE_SHIFT);
+#endif
+}
+
+/*
+ * The volume only follows once the value is VOLUME_FILTER_HYSTERESIS counts past the boundary.
+ * The table ends count as past it, the top level only covers full scale.
+ */
+static bool volume_filter_quantize(uint16_t value)
+{
+    uint8_t  level = VOLUME_LUT[value];
+    uint32_t guard;
+
+    if (level > volume_current)
+    {
+        guard = (value > VOLUME_FILTER_HYSTERESIS) ? (value - VOLUME_FILTER_HYSTERESIS) : 0U;
+        if ((value < VOLUME_FILTER_INPUT_MAX) && (VOLUME_LUT[guard] <= volume_current))
+        {
+            return false;
+        }
+    }
+    else if (level < volume_current)
+    {
+        guard = value + VOLUME_FILTER_HYSTERESIS;
+        if (guard > VOLUME_FILTER_INPUT_MAX)
+        {
+            guard = VOLUME_FILTER_INPUT_MAX;
+        }
+        if ((value > 0U) && (VOLUME_LUT[guard] >= volume_current))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    volume_current = level;
+    return true;
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void volume_filter_init()
+{
+    uint32_t value;
+
+    for (value = 0; value < VOLUME_FILTER_LUT_SIZE; value++)
+    {
+        VOLUME_LUT[value] = (uint8_t)(value * VOLUME_FILTER_SCALE / VOLUME_FILTER_INPUT_MAX + 1U);
+    }
+    volume_primed  = false;
+    volume_current = 0;
+}
+
+bool volume_filter_put(uint16_t sample)
+{
+    if (sample > VOLUME_FILTER_INPUT_MAX)
+    {
+        sample = VOLUME_FILTER_INPUT_MAX;
+    }
+    if (!volume_primed)
+    {
+        volume_filter_prime(sample);
+        volume_primed = true;
+    }
+
+    volume_smoothed = volume_filter_smooth(volume_filter_median(sample));
+
+    return volume_filter_quantize(volume_smoothed);
+}
+
+uint8_t volume_filter_lookup(uint16_t value)
+{
+    return VOLUME_LUT[(value > VOLUME_FILTER_INPUT_MAX) ? VOLUME_FILTER_INPUT_MAX : value];
+}
+
+uint8_t volume_filter_get_volume()
+{
+    return volume_current;
+}
+
+uint16_t volume_filter_get_smoothed()
+{
+    return volume_smoothed;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
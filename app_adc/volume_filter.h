@@ -0,0 +1,79 @@
+#ifndef APP_ADC_VOLUME_FILTER_H_
+#define APP_ADC_VOLUME_FILTER_H_
+
+#include "driver_common.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Full scale of the 12-bit input */
+#define VOLUME_FILTER_INPUT_MAX         4095U
+/* Volume reported at full scale is VOLUME_FILTER_SCALE + 1 */
+#define VOLUME_FILTER_SCALE             100U
+
+/* Smoothing stage */
+#define VOLUME_FILTER_IIR               0
+#define VOLUME_FILTER_MOVING_AVERAGE    1
+
+#ifndef VOLUME_FILTER_MODE
+#define VOLUME_FILTER_MODE              VOLUME_FILTER_IIR
+#endif
+
+/* Samples in the median window, odd, 1 removes the stage */
+#ifndef VOLUME_FILTER_MEDIAN_TAPS
+#define VOLUME_FILTER_MEDIAN_TAPS       3U
+#endif
+
+/* IIR weight of a new sample is 2^-VOLUME_FILTER_IIR_SHIFT */
+#ifndef VOLUME_FILTER_IIR_SHIFT
+#define VOLUME_FILTER_IIR_SHIFT         4U
+#endif
+
+/* Moving average length, must be a power of two */
+#ifndef VOLUME_FILTER_AVERAGE_TAPS
+#define VOLUME_FILTER_AVERAGE_TAPS      16U
+#endif
+
+/* Input counts the smoothed value must go past a volume boundary before the volume follows */
+#ifndef VOLUME_FILTER_HYSTERESIS
+#define VOLUME_FILTER_HYSTERESIS        12U
+#endif
+
+#if ((VOLUME_FILTER_MEDIAN_TAPS & 1U) == 0) || (VOLUME_FILTER_MEDIAN_TAPS > 7U)
+#error "VOLUME_FILTER_MEDIAN_TAPS must be odd and at most 7"
+#endif
+#if (VOLUME_FILTER_AVERAGE_TAPS & (VOLUME_FILTER_AVERAGE_TAPS - 1U)) != 0
+#error "VOLUME_FILTER_AVERAGE_TAPS must be a power of two"
+#endif
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief     build the volume lookup table and reset the filter, the next sample primes every stage
+ */
+void volume_filter_init();
+
+/**
+  \brief         filter one sample
+  \param [in]    sample : conversion result, 0 to VOLUME_FILTER_INPUT_MAX
+  \return        true if the volume changed
+ */
+bool volume_filter_put(uint16_t sample);
+
+/**
+  \brief         volume of a value from the lookup table, without filtering
+  \param [in]    value : input counts, 0 to VOLUME_FILTER_INPUT_MAX
+ */
+uint8_t volume_filter_lookup(uint16_t value);
+
+/**
+  \brief     current volume, 0 before the first sample
+ */
+uint8_t volume_filter_get_volume();
+
+/**
+  \brief     output of the smoothing stage, in input counts
+ */
+uint16_t volume_filter_get_smoothed();
+
+#endif /* APP_ADC_VOLUME_FILTER_H_ */
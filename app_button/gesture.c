@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "gesture.h"
+#include "driver_systick.h"
+#include "sw_timer.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define GESTURE_CYCLES_PER_MS       (SystemCoreClock / 1000U)
+
+typedef enum {
+    BUTTON_IDLE,
+    BUTTON_PRESSED,     /* held, long press not reached yet */
+    BUTTON_RELEASED,    /* between two clicks of a series */
+    BUTTON_HELD,        /* long press reported, waiting for release */
+} button_state_t;
+
+typedef struct {
+    button_state_t state;
+    uint8_t        clicks;
+    uint64_t       since;           /* cycles of the press or release that entered the state */
+    uint64_t       edge;            /* cycles of the last accepted edge */
+    bool           down;            /* level of the last accepted edge */
+    sw_timer_t     timeout;
+} button_t;
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static const gesture_button_t* gesture_table  = NULL;
+static uint8_t                 gesture_count  = 0;
+static gesture_notify_t        gesture_notify = NULL;
+static gesture_report_t        gesture_report = NULL;
+static button_t                BUTTONS[GESTURE_MAX_BUTTONS];
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void gesture_timeout(sw_timer_t* timer)
+{
+    gesture_notify();
+}
+
+static void gesture_emit(uint8_t index, gesture_t gesture)
+{
+    const gesture_action_t* action = &gesture_table[index].actions[gesture];
+
+    if (action->option != 0)
+    {
+        gesture_report(action->option, action->value);
+    }
+}
+
+static bool gesture_elapsed(const button_t* button, uint32_t limit, uint64_t now)
+{
+    return (now - button->since) >= ((uint64_t)limit * GESTURE_CYCLES_PER_MS);
+}
+
+/* Wakes gesture_process() when the current state times out */
+static void gesture_arm(button_t* button, uint32_t limit, uint64_t now)
+{
+    uint64_t deadline = button->since + ((uint64_t)limit * GESTURE_CYCLES_PER_MS);
+    uint32_t delay    = 1U;
+
+    /* Rounded up to the next tick, the timeout must not fire early */
+    if (deadline > now)
+    {
+        delay = (uint32_t)((deadline - now + GESTURE_CYCLES_PER_MS - 1U) / GESTURE_CYCLES_PER_MS);
+    }
+    sw_timer_start(&button->timeout, delay, 0);
+}
+
+/* Applies the timeouts of a button as seen at time now */
+static void gesture_expire(uint8_t index, uint64_t now)
+{
+    button_t* button = &BUTTONS[index];
+
+    if ((button->state == BUTTON_PRESSED) && gesture_elapsed(button, GESTURE_LONG_PRESS_TIME, now))
+    {
+        gesture_emit(index, GESTURE_LONG);
+        button->state = BUTTON_HELD;
+    }
+    else if ((button->state == BUTTON_RELEASED) && gesture_elapsed(button, GESTURE_MULTI_CLICK_TIME, now))
+    {
+        gesture_emit(index, (button->clicks == 1) ? GESTURE_SINGLE : GESTURE_DOUBLE);
+        button->state = BUTTON_IDLE;
+    }
+}
+
+static void gesture_edge(uint8_t index, bool pressed, uint64_t time)
+{
+    button_t* button = &BUTTONS[index];
+
+    /*
+     * Bounce outlasts the PORT filter. Within the debounce time of an accepted edge the
+     * contact settles back to its level, and an edge repeating the level adds nothing.
+     */
+    if ((pressed == button->down)
+            || ((time - button->edge) < ((uint64_t)GESTURE_DEBOUNCE_TIME * GESTURE_CYCLES_PER_MS)))
+    {
+        return;
+    }
+    button->down = pressed;
+    button->edge = time;
+
+    /* A timeout that passed before this edge counts first */
+    gesture_expire(index, time);
+
+    if (pressed)
+    {
+        if (button->state == BUTTON_IDLE)
+        {
+            button->clicks = 0;
+        }
+        if ((button->state == BUTTON_IDLE) || (button->state == BUTTON_RELEASED))
+        {
+            button->state = BUTTON_PRESSED;
+            button->since = time;
+        }
+    }
+    else if (button->state == BUTTON_PRESSED)
+    {
+        button->clicks++;
+        button->since = time;
+        if (button->clicks == 3)
+        {
+            gesture_emit(index, GESTURE_TRIPLE);
+            button->state = BUTTON_IDLE;
+        }
+        else
+        {
+            button->state = BUTTON_RELEASED;
+        }
+    }
+    else if (button->state == BUTTON_HELD)
+    {
+        button->state = BUTTON_IDLE;
+    }
+    else
+    {
+        /* Release without a press seen, e.g. held at start-up */
+    }
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void gesture_init(const gesture_button_t* table, uint8_t count,
+                  gesture_notify_t notify, gesture_report_t report)
+{
+    uint8_t index;
+
+    assert(count <= GESTURE_MAX_BUTTONS);
+
+    gesture_table  = table;
+    gesture_count  = count;
+    gesture_notify = notify;
+    gesture_report = report;
+    for (index = 0; index < count; index++)
+    {
+        BUTTONS[index].state  = BUTTON_IDLE;
+        BUTTONS[index].clicks = 0;
+        BUTTONS[index].edge   = 0;
+        BUTTONS[index].down   = false;
+        sw_timer_init(&BUTTONS[index].timeout, gesture_timeout, NULL);
+    }
+}
+
+void gesture_process()
+{
+    input_event_t event;
+    const gesture_button_t* row;
+    button_t* button;
+    uint64_t now;
+    uint8_t index;
+
+    while (input_event_pop(&event))
+    {
+        for (index = 0; index < gesture_count; index++)
+        {
+            row = &gesture_table[index];
+            if ((row->port == event.port) && (row->pin == event.pin))
+            {
+                gesture_edge(index, (event.edge == INPUT_EDGE_RISING) == row->activeHigh, event.cycles);
+                break;
+            }
+        }
+    }
+
+    now = SysTick_DRV_GetCycles();
+    for (index = 0; index < gesture_count; index++)
+    {
+        button = &BUTTONS[index];
+        gesture_expire(index, now);
+        if (button->state == BUTTON_PRESSED)
+        {
+            gesture_arm(button, GESTURE_LONG_PRESS_TIME, now);
+        }
+        else if (button->state == BUTTON_RELEASED)
+        {
+            gesture_arm(button, GESTURE_MULTI_CLICK_TIME, now);
+        }
+        else
+        {
+            sw_timer_stop(&button->timeout);
+        }
+    }
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
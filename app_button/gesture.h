@@ -0,0 +1,71 @@
+#ifndef APP_BUTTON_GESTURE_H_
+#define APP_BUTTON_GESTURE_H_
+
+#include "driver_common.h"
+#include "driver_port.h"
+#include "driver_gpio.h"
+#include "input_event.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define GESTURE_MAX_BUTTONS         8U
+
+/* Milliseconds, measured between the edge timestamps */
+#define GESTURE_MULTI_CLICK_TIME    500U    /* longest gap between the clicks of one gesture */
+#define GESTURE_LONG_PRESS_TIME     1000U   /* shortest hold reported as a long press */
+/* Edges this soon after the last accepted edge of a button are bounce, so are shorter clicks */
+#define GESTURE_DEBOUNCE_TIME       10U
+
+typedef enum {
+    GESTURE_SINGLE = 0,
+    GESTURE_DOUBLE,
+    GESTURE_TRIPLE,     /* reported on the third release, longer series are not counted */
+    GESTURE_LONG,       /* reported while the button is still held */
+    GESTURE_COUNT,
+} gesture_t;
+
+/* Message reported for a gesture, an option of 0 reports nothing */
+typedef struct {
+    uint8_t option;
+    uint8_t value;
+} gesture_action_t;
+
+/* One row per button, the table must stay valid after gesture_init() */
+typedef struct {
+    PORT_Type*       port;
+    uint8_t          pin;
+    bool             activeHigh;                /* pin level while pressed */
+    gesture_action_t actions[GESTURE_COUNT];
+} gesture_button_t;
+
+/**
+  \brief     asks for gesture_process() to run soon, called when a timeout expires
+ */
+typedef void (*gesture_notify_t)(void);
+
+/**
+  \brief     receives the action of a recognised gesture, called from gesture_process()
+ */
+typedef void (*gesture_report_t)(uint8_t option, uint8_t value);
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         set up the engine, the pins must raise input events on either edge
+  \param [in]    table : button rows
+  \param [in]    count : number of rows, at most GESTURE_MAX_BUTTONS
+  \param [in]    notify : called when a timeout waits for processing
+  \param [in]    report : called for each gesture with an option byte
+ */
+void gesture_init(const gesture_button_t* table, uint8_t count,
+                  gesture_notify_t notify, gesture_report_t report);
+
+/**
+  \brief     classify the queued input events and expired timeouts, called from task context
+
+  Events of pins without a row are discarded.
+ */
+void gesture_process();
+
+#endif /* APP_BUTTON_GESTURE_H_ */
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "input_event.h"
+#include "driver_systick.h"
+#include "ring_buffer.h"
+#include "trace.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+RING_BUFFER_DEFINE(EVENT_QUEUE, input_event_t, INPUT_EVENT_QUEUE_DEPTH);
+
+static input_event_notify_t input_event_notify = NULL;
+static volatile uint32_t    input_event_dropped = 0;
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void input_event_init(input_event_notify_t notify)
+{
+    input_event_t event;
+
+    input_event_notify = notify;
+    /* Edges latched before the time base was running carry no usable timestamp */
+    while (ring_buffer_pop(&EVENT_QUEUE, &event))
+    {
+    }
+}
+
+void input_event_irq_handler(PORT_Type* port, GPIO_Type* gpio)
+{
+    uint32_t flags = PORT_DRV_GetPinsInterruptFlags(port);
+    uint64_t now   = SysTick_DRV_GetCycles();
+    uint32_t levels;
+    uint32_t pending;
+    input_event_t event;
+
+    /* Clear before sampling the levels, a later edge raises the interrupt again */
+    PORT_DRV_ClearPinsInterruptFlags(port, flags);
+    levels = gpio->PDIR;
+
+    event.cycles = now;
+    event.port   = port;
+    for (pending = flags; 0U != pending; pending &= pending - 1U)
+    {
+        event.pin  = (uint8_t)__builtin_ctz(pending);
+        event.edge = (0U != (levels & (1UL << event.pin))) ? INPUT_EDGE_RISING : INPUT_EDGE_FALLING;
+        TRACE(TRACE_BUTTON_EDGE, event.pin, event.edge);
+        if (!ring_buffer_push(&EVENT_QUEUE, &event))
+        {
+            input_event_dropped++;
+        }
+    }
+
+    if ((0U != flags) && (NULL != input_event_notify))
+    {
+        input_event_notify();
+    }
+}
+
+bool input_event_pop(input_event_t* event)
+{
+    return ring_buffer_pop(&EVENT_QUEUE, event);
+}
+
+uint32_t input_event_get_dropped()
+{
+    return input_event_dropped;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
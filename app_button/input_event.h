@@ -0,0 +1,63 @@
+#ifndef APP_BUTTON_INPUT_EVENT_H_
+#define APP_BUTTON_INPUT_EVENT_H_
+
+#include "driver_common.h"
+#include "driver_port.h"
+#include "driver_gpio.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Events waiting for the consumer, must be a power of two */
+#define INPUT_EVENT_QUEUE_DEPTH     16U
+
+typedef enum {
+    INPUT_EDGE_FALLING = 0,
+    INPUT_EDGE_RISING  = 1,
+} input_edge_t;
+
+/* One pin change, as seen by the PORT interrupt */
+typedef struct {
+    uint64_t     cycles;    /* SysTick_DRV_GetCycles() when the interrupt was taken */
+    PORT_Type*   port;
+    uint8_t      pin;
+    input_edge_t edge;      /* from the pin level read in the interrupt */
+} input_event_t;
+
+/**
+  \brief     asks for the queue to be drained soon, called from interrupt context
+ */
+typedef void (*input_event_notify_t)(void);
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         set up the queue
+  \param [in]    notify : called by input_event_irq_handler() after queueing events
+ */
+void input_event_init(input_event_notify_t notify);
+
+/**
+  \brief         PORT interrupt handler
+
+  Reads and clears every flag of the port at once and queues one timestamped event
+  per flagged pin. All callers must share one interrupt priority, the queue has a
+  single producer.
+  \param [in]    port : PORT whose interrupt fired
+  \param [in]    gpio : GPIO of the same port, to read the pin levels
+ */
+void input_event_irq_handler(PORT_Type* port, GPIO_Type* gpio);
+
+/**
+  \brief         take the oldest event, called from task context
+  \param [out]   event : where to copy the event
+  \return        true if an event was taken, false if the queue is empty
+ */
+bool input_event_pop(input_event_t* event);
+
+/**
+  \brief         number of events lost because the queue was full
+ */
+uint32_t input_event_get_dropped();
+
+#endif /* APP_BUTTON_INPUT_EVENT_H_ */
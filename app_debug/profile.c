@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "profile.h"
+#include "encode.h"
+
+#if PROFILE_ENABLE
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[PROFILE_BUCKETS];
+} profile_probe_t;
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static profile_probe_t PROFILE_PROBES[PROFILE_MAX_PROBES];
+
+/* Next record of the dump, the part is 0 for the stats then one per histogram record */
+static uint8_t dump_probe = PROFILE_MAX_PROBES;
+static uint8_t dump_part  = 0;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void profile_snapshot(uint8_t probe, profile_probe_t* copy)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    *copy = PROFILE_PROBES[probe];
+    EnableGlobalIRQ(primask);
+}
+
+static uint8_t* put_u32(uint8_t* data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+    return &data[4];
+}
+
+static bool profile_send(uint8_t probe, uint8_t part)
+{
+    uint8_t data[3 + (PROFILE_DUMP_BUCKETS * 4)];
+    uint8_t* end = &data[2];
+    profile_stats_t stats;
+    profile_probe_t copy;
+    uint8_t first;
+    uint8_t i;
+
+    data[1] = probe;
+    if (part == 0)
+    {
+        (void)profile_get_stats(probe, &stats);
+        data[0] = PROFILE_RECORD_STATS;
+        end = put_u32(end, stats.count);
+        end = put_u32(end, stats.min);
+        end = put_u32(end, stats.max);
+        end = put_u32(end, stats.mean);
+        end = put_u32(end, stats.p99);
+    }
+    else
+    {
+        profile_snapshot(probe, &copy);
+        first   = (uint8_t)((part - 1) * PROFILE_DUMP_BUCKETS);
+        data[0] = PROFILE_RECORD_HISTOGRAM;
+        *end++  = first;
+        for (i = first; (i < PROFILE_BUCKETS) && (i < (first + PROFILE_DUMP_BUCKETS)); i++)
+        {
+            end = put_u32(end, copy.buckets[i]);
+        }
+    }
+
+    return push_record(OPTION_PROFILE, data, (uint8_t)(end - data));
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+bool profile_init()
+{
+    profile_reset();
+    return DWT_DRV_Init();
+}
+
+void profile_reset()
+{
+    uint32_t primask = DisableGlobalIRQ();
+    uint8_t  probe;
+
+    memset(PROFILE_PROBES, 0, sizeof(PROFILE_PROBES));
+    for (probe = 0; probe < PROFILE_MAX_PROBES; probe++)
+    {
+        PROFILE_PROBES[probe].min = UINT32_MAX;
+    }
+    EnableGlobalIRQ(primask);
+}
+
+void profile_record(uint8_t probe, uint32_t cycles)
+{
+    profile_probe_t* p = &PROFILE_PROBES[probe];
+    uint32_t bucket = (cycles == 0U) ? 0U : (32U - (uint32_t)__builtin_clz(cycles));
+
+    if (bucket >= PROFILE_BUCKETS)
+    {
+        bucket = PROFILE_BUCKETS - 1U;
+    }
+
+    p->count++;
+    p->sum += cycles;
+    if (cycles < p->min)
+    {
+        p->min = cycles;
+    }
+    if (cycles > p->max)
+    {
+        p->max = cycles;
+    }
+    p->buckets[bucket]++;
+}
+
+bool profile_get_stats(uint8_t probe, profile_stats_t* stats)
+{
+    profile_probe_t copy;
+    uint32_t target;
+    uint32_t seen = 0;
+    uint32_t bucket;
+
+    profile_snapshot(probe, &copy);
+    if (copy.count == 0U)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return false;
+    }
+
+    /* Smallest bucket bound with at least 99% of the samples at or below it */
+    target = copy.count - (copy.count / 100U);
+    for (bucket = 0; bucket < (PROFILE_BUCKETS - 1U); bucket++)
+    {
+        seen += copy.buckets[bucket];
+        if (seen >= target)
+        {
+            break;
+        }
+    }
+
+    stats->count = copy.count;
+    stats->min   = copy.min;
+    stats->max   = copy.max;
+    stats->mean  = (uint32_t)(copy.sum / copy.count);
+    stats->p99   = (bucket < (PROFILE_BUCKETS - 1U)) ? ((1UL << bucket) - 1U) : copy.max;
+    if (stats->p99 > copy.max)
+    {
+        stats->p99 = copy.max;
+    }
+    return true;
+}
+
+void profile_dump_start()
+{
+    dump_probe = 0;
+    dump_part  = 0;
+}
+
+bool profile_dump_step()
+{
+    const uint8_t parts = 1U + ((PROFILE_BUCKETS + PROFILE_DUMP_BUCKETS - 1U) / PROFILE_DUMP_BUCKETS);
+
+    /* Legacy frames carry a single byte, tell the host to select v2 instead */
+    if ((encode_get_protocol() != PROTOCOL_V2) && (dump_probe < PROFILE_MAX_PROBES))
+    {
+        if (!push_message(OPTION_PROFILE, PROFILE_REPLY_NEED_V2))
+        {
+            return false;
+        }
+        dump_probe = PROFILE_MAX_PROBES;
+    }
+
+    while (dump_probe < PROFILE_MAX_PROBES)
+    {
+        if (PROFILE_PROBES[dump_probe].count == 0U)
+        {
+            dump_probe++;
+            continue;
+        }
+        if (!profile_send(dump_probe, dump_part))
+        {
+            return false;
+        }
+        dump_part++;
+        if (dump_part == parts)
+        {
+            dump_part = 0;
+            dump_probe++;
+        }
+    }
+    return true;
+}
+#endif
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
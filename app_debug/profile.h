@@ -0,0 +1,96 @@
+#ifndef APP_DEBUG_PROFILE_H_
+#define APP_DEBUG_PROFILE_H_
+
+#include "driver_common.h"
+#include "driver_dwt.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Build with -DPROFILE_ENABLE=0 to remove every probe and the module itself */
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE          1
+#endif
+
+#define PROFILE_MAX_PROBES      12U
+/* Bucket b counts durations of 2^(b-1) to 2^b - 1 cycles, the last one also every longer one */
+#define PROFILE_BUCKETS         24U
+#define PROFILE_DUMP_BUCKETS    6U      /* buckets per histogram record */
+
+/* Value byte of an OPTION_PROFILE command */
+#define PROFILE_CMD_DUMP        '0'
+#define PROFILE_CMD_RESET       'r'
+/* Value byte of the OPTION_PROFILE reply to a dump requested in legacy mode */
+#define PROFILE_REPLY_NEED_V2   'e'
+
+/* First data byte of the records sent by profile_dump_step() */
+#define PROFILE_RECORD_STATS        0U  /* type | probe | count | min | max | mean | p99 */
+#define PROFILE_RECORD_HISTOGRAM    1U  /* type | probe | first bucket | PROFILE_DUMP_BUCKETS counts */
+
+/* Summary of one probe, durations in core clock cycles */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;
+    uint32_t p99;       /* upper bound of the bucket holding the 99th percentile */
+} profile_stats_t;
+
+#if PROFILE_ENABLE
+/* Opens a measurement, once per block */
+#define PROFILE_START()         uint32_t profile_start = DWT_DRV_GetCycles()
+/* Closes the measurement opened in the same block and records it under probe */
+#define PROFILE_STOP(probe)     profile_record((probe), DWT_DRV_GetCycles() - profile_start)
+#else
+#define PROFILE_START()
+#define PROFILE_STOP(probe)
+#endif
+
+#if PROFILE_ENABLE
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief     start the DWT cycle counter and clear every probe
+  \return    false if the core has no cycle counter
+ */
+bool profile_init();
+
+/**
+  \brief     clear every probe
+ */
+void profile_reset();
+
+/**
+  \brief         add one duration to a probe
+
+  A probe must only be recorded from one context, probes need no locking then.
+  \param [in]    probe : probe id below PROFILE_MAX_PROBES
+  \param [in]    cycles : duration in core clock cycles
+ */
+void profile_record(uint8_t probe, uint32_t cycles);
+
+/**
+  \brief         summary of a probe
+  \param [in]    probe : probe id below PROFILE_MAX_PROBES
+  \param [out]   stats : summary, only written if the probe has samples
+  \return        true if the probe has samples
+ */
+bool profile_get_stats(uint8_t probe, profile_stats_t* stats);
+
+/**
+  \brief     restart the dump from the first probe
+ */
+void profile_dump_start();
+
+/**
+  \brief     send the next OPTION_PROFILE records with push_record(), needs PROTOCOL_V2
+
+  Sends as many records as the TX ring takes, call again until it returns true.
+  The records stay in the v2 batch until flush_records(). In legacy mode the dump
+  is dropped and a PROFILE_REPLY_NEED_V2 frame is sent instead.
+  \return    true once every probe with samples or the reply was sent
+ */
+bool profile_dump_step();
+#endif
+
+#endif /* APP_DEBUG_PROFILE_H_ */
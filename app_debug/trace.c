@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "trace.h"
+#include "encode.h"
+
+#if TRACE_ENABLE
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Set in trace_head while a dump runs, so that freezing and claiming are one atomic each */
+#define TRACE_FROZEN        0x80000000U
+#define TRACE_COUNT_MASK    0x7FFFFFFFU
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static trace_record_t TRACE_RING[TRACE_DEPTH];
+
+/* Free running count of claimed slots, the slot is its low bits, plus TRACE_FROZEN */
+static volatile uint32_t trace_head    = 0;
+
+/* Dump position, from the oldest record to the head at trace_dump_start() */
+static uint32_t dump_next = 0;
+static uint32_t dump_end  = 0;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static uint8_t* put_record(uint8_t* data, const trace_record_t* record)
+{
+    data[0] = (uint8_t)record->timestamp;
+    data[1] = (uint8_t)(record->timestamp >> 8);
+    data[2] = (uint8_t)(record->timestamp >> 16);
+    data[3] = (uint8_t)(record->timestamp >> 24);
+    data[4] = record->event;
+    data[5] = record->arg8;
+    data[6] = (uint8_t)record->arg16;
+    data[7] = (uint8_t)(record->arg16 >> 8);
+    return &data[sizeof(trace_record_t)];
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void trace_init()
+{
+    (void)DWT_DRV_Init();
+    trace_clear();
+}
+
+void trace_clear()
+{
+    trace_head   = 0;
+    dump_next    = 0;
+    dump_end     = 0;
+}
+
+void trace_record(trace_event_t event, uint8_t arg8, uint16_t arg16)
+{
+    trace_record_t* record;
+    uint32_t        head = trace_head;
+
+    /*
+     * LDREX/STREX on Cortex-M4, no interrupt masking. The frozen bit is tested in the same
+     * exchange that claims the slot, so no slot at or past the dump end is ever written.
+     */
+    do
+    {
+        if (0U != (head & TRACE_FROZEN))
+        {
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&trace_head, &head, (head + 1U) & TRACE_COUNT_MASK,
+                                          true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    record = &TRACE_RING[head & (TRACE_DEPTH - 1U)];
+    record->timestamp = DWT_DRV_GetCycles();
+    record->event     = (uint8_t)event;
+    record->arg8      = arg8;
+    record->arg16     = arg16;
+}
+
+void trace_dump_start()
+{
+    dump_end     = __atomic_fetch_or(&trace_head, TRACE_FROZEN, __ATOMIC_RELAXED) & TRACE_COUNT_MASK;
+    dump_next    = (dump_end > TRACE_DEPTH) ? (dump_end - TRACE_DEPTH) : 0U;
+}
+
+bool trace_dump_step()
+{
+    uint8_t  data[TRACE_RECORDS_PER_DUMP * sizeof(trace_record_t)];
+    uint8_t* end;
+    uint32_t next;
+
+    /* Legacy frames carry a single byte, tell the host to select v2 instead */
+    if ((encode_get_protocol() != PROTOCOL_V2) && (0U != (trace_head & TRACE_FROZEN)))
+    {
+        if (!push_message(OPTION_TRACE, TRACE_REPLY_NEED_V2))
+        {
+            return false;
+        }
+        dump_next = dump_end;
+    }
+
+    while (dump_next != dump_end)
+    {
+        end  = data;
+        next = dump_next;
+        while ((next != dump_end) && (end < &data[sizeof(data)]))
+        {
+            end = put_record(end, &TRACE_RING[next & (TRACE_DEPTH - 1U)]);
+            next++;
+        }
+        if (!push_record(OPTION_TRACE, data, (uint8_t)(end - data)))
+        {
+            return false;
+        }
+        dump_next = next;
+    }
+
+    (void)__atomic_fetch_and(&trace_head, TRACE_COUNT_MASK, __ATOMIC_RELAXED);
+    return true;
+}
+#endif
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,92 @@
+#ifndef APP_DEBUG_TRACE_H_
+#define APP_DEBUG_TRACE_H_
+
+#include "driver_common.h"
+#include "driver_dwt.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Build with -DTRACE_ENABLE=0 to remove every trace point and the module itself */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            1
+#endif
+
+/* Number of records kept, must be a power of two, the oldest are overwritten */
+#define TRACE_DEPTH             256U
+#define TRACE_RECORDS_PER_DUMP  3U      /* trace records per v2 record */
+
+/* Value byte of an OPTION_TRACE command */
+#define TRACE_CMD_DUMP          '0'
+#define TRACE_CMD_CLEAR         'c'
+/* Value byte of the OPTION_TRACE reply to a dump requested in legacy mode */
+#define TRACE_REPLY_NEED_V2     'e'
+
+/*
+ * Trace record, 8 bytes sent little endian:
+ *   bytes 0..3  timestamp, DWT cycle count, wraps every 2^32 core clock cycles
+ *   byte  4     event, trace_event_t
+ *   byte  5     arg8, see the event
+ *   bytes 6..7  arg16, see the event
+ * A dump sends the records oldest first, TRACE_RECORDS_PER_DUMP per OPTION_TRACE record.
+ */
+typedef enum {
+    TRACE_RX_BYTE       = 1,    /* arg8 byte received */
+    TRACE_FRAME_PARSED  = 2,    /* arg8 option, arg16 value */
+    TRACE_PUSH_MESSAGE  = 3,    /* arg8 option, arg16 value, bit 8 set if the TX ring refused it */
+    TRACE_BUTTON_EDGE   = 4,    /* arg8 pin, arg16 1 on a rising edge and 0 on a falling one */
+    TRACE_ADC_SAMPLE    = 5,    /* arg8 scan group, arg16 filtered result, raw with ADC_COMPARE_ENABLE */
+    TRACE_LED_CHANGE    = 6,    /* arg8 colour index, 0xFF when turned off */
+} trace_event_t;
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t  event;
+    uint8_t  arg8;
+    uint16_t arg16;
+} trace_record_t;
+
+#if TRACE_ENABLE
+#define TRACE(event, arg8, arg16)   trace_record((event), (uint8_t)(arg8), (uint16_t)(arg16))
+#else
+#define TRACE(event, arg8, arg16)
+#endif
+
+#if TRACE_ENABLE
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief     start the DWT cycle counter used for timestamps and clear the ring
+ */
+void trace_init();
+
+/**
+  \brief     drop every record
+ */
+void trace_clear();
+
+/**
+  \brief         add a record, lock-free and callable from any context
+
+  The slot is claimed with an atomic increment, so interrupts of any priority
+  may record at the same time. Records are dropped while a dump is running.
+ */
+void trace_record(trace_event_t event, uint8_t arg8, uint16_t arg16);
+
+/**
+  \brief     freeze the ring and restart the dump from the oldest record
+ */
+void trace_dump_start();
+
+/**
+  \brief     send the next OPTION_TRACE records with push_record(), needs PROTOCOL_V2
+
+  Sends as many records as the TX ring takes, call again until it returns true.
+  Recording resumes once the dump is complete. In legacy mode the dump is dropped
+  and a TRACE_REPLY_NEED_V2 frame is sent instead, the records are kept.
+  \return    true once every record or the reply was sent
+ */
+bool trace_dump_step();
+#endif
+
+#endif /* APP_DEBUG_TRACE_H_ */
@@ -3,6 +3,37 @@
  ******************************************************************************/
 #include "app_init.h"
 
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Channel groups converted per trigger */
+#if ADC_COMPARE_ENABLE
+#define ADC_GROUP_COUNT     1U
+#else
+#define ADC_GROUP_COUNT     ADC_SCAN_CHANNEL_COUNT
+#endif
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* ADC0 settings, also the input of the sample-rate plan */
+static const adc_config_t ADC_CONFIG =
+{
+    .referenceVoltageSource     = ADC_ReferenceVoltageSourceVref,
+    .clockSource                = ADC_ClockSourceAlt0,
+    .clockDivider               = ADC_ClockDivider1,
+    .resolution                 = ADC_Resolution12Bit,
+    .sampleClockCount           = 13U,
+    .enableContinuousConversion = false,
+    .triggerType                = ADC_TriggerTypeHardware,
+#if ADC_COMPARE_ENABLE
+    .dmaEnable                  = false,
+#else
+    .dmaEnable                  = true,
+#endif
+    .hardwareAverage            = ADC_HardwareAverageCount4,
+};
+
 /******************************************************************************
  * Code
  ******************************************************************************/
@@ -30,6 +61,11 @@ void initGPIO()
     {
         .pinDirection = GPIO_DigitalInput,
     };
+    port_digital_filter_config_t SWITCHs_filter =
+    {
+        .clockSource = PORT_FilterClockLpo,
+        .width       = SWITCH_FILTER_WIDTH,
+    };
 
 
     /* Enable PORTs clock */
@@ -43,32 +79,34 @@ void initGPIO()
 
     /* SWITCHs init */
     PORT_DRV_SetPinMux(PORTC, 12, 1);
-    PORT_DRV_SetPinInterruptConfig(PORTC, 12, PORT_InterruptRisingEdge);
+    PORT_DRV_SetPinInterruptConfig(PORTC, 12, PORT_InterruptEitherEdge);
     GPIO_DRV_PinInit(PTC, 12, &SWITCHs_config);
     PORT_DRV_SetPinMux(PORTC, 13, 1);
-    PORT_DRV_SetPinInterruptConfig(PORTC, 13, PORT_InterruptRisingEdge);
+    PORT_DRV_SetPinInterruptConfig(PORTC, 13, PORT_InterruptEitherEdge);
     GPIO_DRV_PinInit(PTC, 13, &SWITCHs_config);
+    PORT_DRV_SetDigitalFilterConfig(PORTC, &SWITCHs_filter);
+    PORT_DRV_EnablePinsDigitalFilter(PORTC, (1UL << SWITCH_2_PIN) | (1UL << SWITCH_3_PIN), true);
+    /* Drop any edge latched before the filter was enabled */
+    PORT_DRV_ClearPinsInterruptFlags(PORTC, (1UL << SWITCH_2_PIN) | (1UL << SWITCH_3_PIN));
+    NVIC_SetPriority(PORTC_IRQn, IRQ_PRIORITY_BUTTON);
     NVIC_EnableIRQ(PORTC_IRQn);
 }
 
 void initADC()
 {
-    adc_config_t         init_config =
+#if ADC_COMPARE_ENABLE
+    /* The first result always completes, ADC0_IRQHandler then opens the window around it */
+    adc_channel_config_t scan_config[ADC_GROUP_COUNT] =
     {
-        .referenceVoltageSource     = ADC_ReferenceVoltageSourceVref,
-        .clockSource                = ADC_ClockSourceAlt0,
-        .clockDivider               = ADC_ClockDivider1,
-        .resolution                 = ADC_Resolution12Bit,
-        .sampleClockCount           = 13U,
-        .enableContinuousConversion = false,
-        .triggerType                = ADC_TriggerTypeHardware,
-        .dmaEnable                  = true,
+        [ADC_SCAN_VOLUME] = { .channelNumber = 12U, .enableInterruptOnConversionCompleted = true },
     };
-    adc_channel_config_t channel_config =
+#else
+    adc_channel_config_t scan_config[ADC_GROUP_COUNT] =
     {
-        .channelNumber                        = 12U,
-        .enableInterruptOnConversionCompleted = false,
+        [ADC_SCAN_VOLUME] = { .channelNumber = 12U, .enableInterruptOnConversionCompleted = false },
+        [ADC_SCAN_AUX]    = { .channelNumber = 13U, .enableInterruptOnConversionCompleted = false },
     };
+#endif
 
     /* ADC0 clock config */
     CLOCK_DRV_DisableClock(CLOCK_ADC0);
@@ -76,13 +114,21 @@ void initADC()
     CLOCK_DRV_EnableClock(CLOCK_ADC0);
 
     /* ADC0 init */
-    ADC_DRV_Init(ADC0, &init_config);
-    /* ADC0 channel 0 config */
-    ADC_DRV_SetChannelConfig(ADC0, 0, &channel_config);
+    ADC_DRV_Init(ADC0, &ADC_CONFIG);
+    /* ADC0 channel groups of the scan */
+    ADC_DRV_SetScanConfig(ADC0, scan_config, ADC_GROUP_COUNT);
+#if ADC_COMPARE_ENABLE
+    ADC_DRV_SetHardwareCompareConfig(ADC0, NULL);
+    NVIC_SetPriority(ADC0_IRQn, IRQ_PRIORITY_ADC);
+    NVIC_EnableIRQ(ADC0_IRQn);
+#endif
 }
 
-void initUART()
+void initUART(lpuart_rx_callback_t rxCallback)
 {
+#if UART_RX_DMA_ENABLE
+    static uint8_t rxBuffer[UART_RX_DMA_BUFFER_SIZE];
+#endif
     lpuart_config_t init_config =
     {
         .baudRate_Bps  = 115200u,
@@ -92,6 +138,19 @@ void initUART()
         .stopBitCount  = LPUART_OneStopBit,
         .enableTx      = true,
         .enableRx      = true,
+        .enableTxFifo  = true,
+        .enableRxFifo  = true,
+        /* Refill the TX FIFO while one word is still shifting out */
+        .txFifoWatermark = 1U,
+#if UART_RX_DMA_ENABLE
+        /* Request the DMA for every received word */
+        .rxFifoWatermark = 0U,
+        .rxIdleTimeout   = LPUART_RxIdleTimeoutDisabled,
+#else
+        /* Interrupt every 3 words, or as soon as the line goes idle */
+        .rxFifoWatermark = 2U,
+        .rxIdleTimeout   = LPUART_RxIdleTimeout1Char,
+#endif
     };
 
     /* LPUART1 clock config */
@@ -106,9 +165,36 @@ void initUART()
     /* LPUART init */
     LPUART_DRV_Init(LPUART1, &init_config, SystemCoreClock);
 
+#if UART_RX_DMA_ENABLE
+    /* Route LPUART1 Rx requests to the Rx DMA channel */
+    CLOCK_DRV_EnableClock(CLOCK_DMAMUX);
+    DMAMUX_DRV_ChannelDisable(DMAMUX, DMA_CHANNEL_UART_RX);
+    DMAMUX_DRV_ChannelSourceSelect(DMAMUX, DMA_CHANNEL_UART_RX, DMAMUX_LPUART1_RX);
+    DMAMUX_DRV_ChannelEnable(DMAMUX, DMA_CHANNEL_UART_RX);
+    /* Receive into the circular buffer, spans are delivered on idle line */
+    LPUART_DRV_EnableRxDMA(LPUART1, DMA, DMA_CHANNEL_UART_RX,
+                           rxBuffer, sizeof(rxBuffer), rxCallback);
+    NVIC_SetPriority(DMA2_IRQn, IRQ_PRIORITY_UART_RX);
+    NVIC_EnableIRQ(DMA2_IRQn);
+#else
+    (void)rxCallback;
     /* Enable Rx interrupt */
     LPUART1->CTRL |= LPUART_CTRL_RIE(1);
+#endif
+    NVIC_SetPriority(LPUART1_RxTx_IRQn, IRQ_PRIORITY_UART_RX);
     NVIC_EnableIRQ(LPUART1_RxTx_IRQn);
+
+#if UART_TX_DMA_ENABLE
+    /* Route LPUART1 Tx requests to the Tx DMA channel */
+    CLOCK_DRV_EnableClock(CLOCK_DMAMUX);
+    DMAMUX_DRV_ChannelDisable(DMAMUX, DMA_CHANNEL_UART_TX);
+    DMAMUX_DRV_ChannelSourceSelect(DMAMUX, DMA_CHANNEL_UART_TX, DMAMUX_LPUART1_TX);
+    DMAMUX_DRV_ChannelEnable(DMAMUX, DMA_CHANNEL_UART_TX);
+    /* Switch LPUART1 Tx to DMA mode */
+    LPUART_DRV_EnableTxDMA(LPUART1, DMA, DMA_CHANNEL_UART_TX);
+    NVIC_SetPriority(DMA1_IRQn, IRQ_PRIORITY_UART_TX);
+    NVIC_EnableIRQ(DMA1_IRQn);
+#endif
 }
 
 void initLPIT()
@@ -136,45 +222,81 @@ void initLPIT()
     /* LPIT disable all interrupt */
     LPIT_DRV_DisableInterrupts(LPIT0, (LPIT_MIER_TIE0_MASK | LPIT_MIER_TIE1_MASK |
                                        LPIT_MIER_TIE2_MASK | LPIT_MIER_TIE3_MASK));
-    /* LPIT channel 0 setup config */
+    /* LPIT channel 0 setup config, its period is planned by initTrigger() */
     LPIT_DRV_SetupChannel(LPIT0, LPIT_Chnl_0, &chnlSetup);
-    /* LPIT channel 0 timer config */
-    LPIT_DRV_SetTimerPeriod(LPIT0, LPIT_Chnl_0, SystemCoreClock/10 - 1);
-    /* LPIT channel 0 start timer */
-    LPIT_DRV_StartTimer(LPIT0, LPIT_Chnl_0);
 }
 
-void initSIM()
+adc_plan_status_t initTrigger(uint32_t sampleRateHz, adc_plan_t *plan)
 {
-    sim_adc0_opt_t option =
+    adc_plan_request_t request =
     {
-        .ADC_Trigger_source    = SIM_ADC_TriggerSource_TRGMUX,
-        .ADC_PreTrigger_source = SIM_ADC_PreTriggerSource_TRGMUX,
+        .sampleRateHz = sampleRateHz,
+        .adc          = &ADC_CONFIG,
+        .groupCount   = ADC_GROUP_COUNT,
+        .lpit         = LPIT0,
+        .lpitChannel  = LPIT_Chnl_0,
     };
-    /* ADC0 option setting */
-    SIM_DRV_ADC0option(&option);
-    /* Setup ADC0 trigger source to LPIT_CH0 via TRGMUX */
-    TRGMUX_DRV_SetTriggerSource(TRGMUX, TRGMUX_ADC0_INDEX, TRGMUX_TriggerInput0,
-                                                        TRGMUX_Source_LPIT_CH0);
+    adc_plan_status_t status;
+
+    /* SIM, TRGMUX and LPIT0 channel 0 are programmed together, once the scan fits */
+    status = adc_plan_apply(&request, plan);
+    if (ADC_PLAN_RATE_TOO_HIGH == status)
+    {
+        /* Run at the hardware limit rather than not at all */
+        request.sampleRateHz = adc_plan_max_rate(&request);
+        status = adc_plan_apply(&request, plan);
+    }
+
+    return status;
 }
 
 void initDMA(uint32_t storing_address)
 {
+    static uint32_t blockScratch;
+    /* One request per conversion, reading R[0..N-1] in turn, the major loop is one frame */
     dma_channel_config_t config =
     {
         .srcAddr          = (uint32_t)&(ADC0->R[0]),
         .srcTransferSize  = DMA_TRANSFER_SIZE_4B,
         .destAddr         = storing_address,
         .destTransferSize = DMA_TRANSFER_SIZE_4B,
+        .srcOffset        = 4,
+        .destOffset       = 4,
+        .minorLoopBytes   = 4U,
+        .majorLoopCount   = ADC_SCAN_CHANNEL_COUNT,
+        .srcLastAdjust    = -(int32_t)(ADC_SCAN_CHANNEL_COUNT * 4U),
+        .destLastAdjust   = 0,
+        /* Frames follow each other, the modulo wraps the last one back to the first */
+        .destModulo       = (uint8_t)__builtin_ctz(ADC_SCAN_RING_BYTES),
+        /* Count the frame on the block channel */
+        .enableMajorLink  = true,
+        .majorLinkChannel = DMA_CHANNEL_ADC_BLOCK,
+    };
+    /* Moves one word in place per frame, its half and major interrupts mark the ready block */
+    dma_channel_config_t block_config =
+    {
+        .srcAddr              = (uint32_t)&blockScratch,
+        .srcTransferSize      = DMA_TRANSFER_SIZE_4B,
+        .destAddr             = (uint32_t)&blockScratch,
+        .destTransferSize     = DMA_TRANSFER_SIZE_4B,
+        .minorLoopBytes       = 4U,
+        .majorLoopCount       = ADC_SCAN_FRAME_COUNT,
+        .enableHalfInterrupt  = true,
+        .enableMajorInterrupt = true,
     };
+    /* Block channel config, only started by the link */
+    DMA_DRV_SetChannelConfig(DMA, DMA_CHANNEL_ADC_BLOCK, &block_config);
+    DMA_DRV_DisableChannelRequest(DMA, DMA_CHANNEL_ADC_BLOCK);
+    NVIC_SetPriority(DMA3_IRQn, IRQ_PRIORITY_ADC);
+    NVIC_EnableIRQ(DMA3_IRQn);
     /* DMA channel 0 config */
-    DMA_DRV_SetChannelConfig(DMA, 0, &config);
+    DMA_DRV_SetChannelConfig(DMA, DMA_CHANNEL_ADC, &config);
     /* Enable DMAMUX clock */
     CLOCK_DRV_EnableClock(CLOCK_DMAMUX);
     /* Config trigger source for DMA channel 0 to ADC0 */
-    DMAMUX_DRV_ChannelDisable(DMAMUX, 0);
-    DMAMUX_DRV_ChannelSourceSelect(DMAMUX, 0, DMAMUX_ADC0);
-    DMAMUX_DRV_ChannelEnable(DMAMUX, 0);
+    DMAMUX_DRV_ChannelDisable(DMAMUX, DMA_CHANNEL_ADC);
+    DMAMUX_DRV_ChannelSourceSelect(DMAMUX, DMA_CHANNEL_ADC, DMAMUX_ADC0);
+    DMAMUX_DRV_ChannelEnable(DMAMUX, DMA_CHANNEL_ADC);
 }
 
 void initFTM() {
@@ -18,6 +18,8 @@
 #include "driver_dmamux.h"
 #include "driver_systick.h"
 #include "driver_ftm.h"
+#include "adc_scan.h"
+#include "adc_plan.h"
 
 /******************************************************************************
  * Definitions
@@ -28,6 +30,57 @@
 #define SWITCH_2_PIN         12
 #define SWITCH_3_PIN         13
 
+/*
+ * PORTC digital filter on the switches, in LPO cycles at 128 kHz. Bounce shorter than
+ * this never raises PORTC_IRQn, longer bounce is dropped by GESTURE_DEBOUNCE_TIME.
+ */
+#define SWITCH_FILTER_WIDTH  31U    /* ~240 us, the widest the filter allows */
+
+/*
+ * ADC0 scan, every LPIT0 channel 0 period converts groups 0 to ADC_SCAN_CHANNEL_COUNT - 1
+ * into one frame of the scan ring, each result the mean of 4 conversions
+ */
+#define ADC_SAMPLE_RATE_HZ   1000U   /* requested, the achieved rate comes from the plan */
+#define ADC_SCAN_VOLUME      0U     /* group of the potentiometer, ADC0_SE12 on PTC14 */
+#define ADC_SCAN_AUX         1U     /* group of ADC0_SE13 on PTC15 */
+
+/*
+ * Convert the potentiometer alone and keep only results outside a window around the last
+ * one, raising ADC0_IRQn. The CPU sleeps while the knob is still, but the compare applies
+ * to every group, so this replaces the DMA scan, its blocks and the filter pipeline.
+ */
+#define ADC_COMPARE_ENABLE   0
+#define ADC_COMPARE_WINDOW   24U    /* counts either side of the last result */
+
+/* DMA channel allocation, each channel has its own DMAn_IRQHandler */
+#define DMA_CHANNEL_ADC      0U
+#define DMA_CHANNEL_UART_TX  1U
+#define DMA_CHANNEL_UART_RX  2U
+#define DMA_CHANNEL_ADC_BLOCK 3U    /* no request source, counts the frames of DMA_CHANNEL_ADC */
+
+/* Transmit LPUART1 frames through eDMA instead of the TDRE interrupt */
+#define UART_TX_DMA_ENABLE   1
+
+/* Receive LPUART1 through a circular eDMA buffer instead of one interrupt per byte */
+#define UART_RX_DMA_ENABLE       1
+#define UART_RX_DMA_BUFFER_SIZE  64U
+
+/*
+ * NVIC priorities, lower values preempt higher ones. UART receive and the buttons
+ * preempt the transmit and tick work, whose critical sections only mask their own level.
+ */
+#define IRQ_PRIORITY_SYSTICK     0U     /* SysTick, only counts the tick and pends the tick work */
+#define IRQ_PRIORITY_UART_RX     1U     /* LPUART1 and its Rx DMA channel */
+#define IRQ_PRIORITY_BUTTON      2U     /* PORTC */
+#define IRQ_PRIORITY_UART_TX     3U     /* Tx DMA channel */
+#define IRQ_PRIORITY_TICK        4U     /* PendSV tick work and the tickless wakeup, see SW_TIMER_IRQ_PRIORITY */
+#define IRQ_PRIORITY_ADC         4U     /* ADC block DMA channel or ADC0 compare */
+
+/* Sleep through idle SysTick periods, woken by an LPIT one-shot at the next timer deadline */
+#define TICKLESS_IDLE_ENABLE     1
+#define TICKLESS_LPIT_CHANNEL    LPIT_Chnl_1
+#define TICKLESS_LPIT_IRQn       LPIT0_Ch1_IRQn
+
 /******************************************************************************
  * API
  ******************************************************************************/
@@ -40,19 +93,32 @@ void initGPIO();
 /* @brief Initialize the ADC module. */
 void initADC();
 
-/* @brief Initialize the UART module. */
-void initUART();
+/**
+ * @brief Initialize the UART module.
+ *
+ * @param rxCallback  function receiving the bytes read from LPUART1.
+ */
+void initUART(lpuart_rx_callback_t rxCallback);
 
 /* @brief Initialize the LPIT module. */
 void initLPIT();
 
-/* @brief Initialize the SIM module. */
-void initSIM();
+/**
+ * @brief Plan the ADC sample rate and start the LPIT -> TRGMUX -> ADC0 trigger chain.
+ *
+ * Programs SIM, TRGMUX and LPIT0 channel 0 together. A rate too high for the scan is
+ * lowered to the highest one that fits. Call after initADC(), initLPIT() and initDMA().
+ *
+ * @param sampleRateHz  requested scans per second.
+ * @param plan          achieved timing.
+ * @return ADC_PLAN_OK once the chain runs.
+ */
+adc_plan_status_t initTrigger(uint32_t sampleRateHz, adc_plan_t *plan);
 
 /**
  * @brief Initialize the DMA module.
  *
- * @param storing_address   address to store DMA destination.
+ * @param storing_address   address of the ADC scan ring, aligned to ADC_SCAN_RING_BYTES.
  */
 void initDMA(uint32_t storing_address);
 
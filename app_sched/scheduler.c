@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "scheduler.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static sched_task_t SCHED_TASKS[SCHED_MAX_TASKS];
+static sched_idle_t sched_idle = NULL;
+
+static volatile uint32_t sched_pending   = 0;
+static volatile bool     sched_sleeping  = false;
+static volatile uint32_t tick_count      = 0;
+static volatile uint32_t idle_tick_count = 0;
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void sched_register(uint8_t id, sched_task_t task)
+{
+    assert(id < SCHED_MAX_TASKS);
+
+    SCHED_TASKS[id] = task;
+}
+
+void sched_set_idle(sched_idle_t idle)
+{
+    sched_idle = idle;
+}
+
+void sched_post(uint8_t id)
+{
+    uint32_t primask;
+
+    assert(id < SCHED_MAX_TASKS);
+
+    /* Interrupts of different priorities may post at the same time */
+    primask = DisableGlobalIRQ();
+    sched_pending |= (1UL << id);
+    EnableGlobalIRQ(primask);
+}
+
+void sched_tick()
+{
+    tick_count++;
+    if (sched_sleeping)
+    {
+        idle_tick_count++;
+    }
+}
+
+void sched_run()
+{
+    uint32_t primask;
+    uint32_t pending;
+    uint8_t  id;
+
+    while (1)
+    {
+        /* Checked with interrupts masked, an event posted now still wakes WFI */
+        primask = DisableGlobalIRQ();
+        pending = sched_pending;
+        if (pending == 0)
+        {
+            sched_sleeping = true;
+            if (sched_idle != NULL)
+            {
+                sched_idle();
+            }
+            else
+            {
+                __DSB();
+                __WFI();
+            }
+            /* The waking interrupt runs here and still sees the core asleep */
+            EnableGlobalIRQ(primask);
+            sched_sleeping = false;
+            continue;
+        }
+
+        id = (uint8_t)__builtin_ctz(pending);
+        sched_pending = pending & ~(1UL << id);
+        EnableGlobalIRQ(primask);
+
+        if (SCHED_TASKS[id] != NULL)
+        {
+            SCHED_TASKS[id]();
+        }
+    }
+}
+
+uint32_t sched_get_tick_count()
+{
+    return tick_count;
+}
+
+uint32_t sched_get_idle_tick_count()
+{
+    return idle_tick_count;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
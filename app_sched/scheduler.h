@@ -0,0 +1,71 @@
+#ifndef APP_SCHED_SCHEDULER_H_
+#define APP_SCHED_SCHEDULER_H_
+
+#include "driver_common.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* One pending bit per task, the task id is also its priority, 0 runs first */
+#define SCHED_MAX_TASKS         32U
+
+/**
+  \brief     task body, runs to completion once per batch of posted events
+ */
+typedef void (*sched_task_t)(void);
+
+/**
+  \brief     idle function used in place of WFI
+
+  Called with interrupts masked, it must return with them still masked. A
+  pending interrupt is taken as soon as the scheduler unmasks them.
+ */
+typedef void (*sched_idle_t)(void);
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         register the task run when its event is posted
+  \param [in]    id : task id below SCHED_MAX_TASKS, lower ids have higher priority
+  \param [in]    task : function to run
+ */
+void sched_register(uint8_t id, sched_task_t task);
+
+/**
+  \brief         replace the WFI executed when no task is pending
+  \param [in]    idle : idle function, NULL restores WFI
+ */
+void sched_set_idle(sched_idle_t idle);
+
+/**
+  \brief         mark a task ready, callable from interrupt handlers
+
+  Posting a task that is already pending is merged into one run.
+  \param [in]    id : task id given to sched_register()
+ */
+void sched_post(uint8_t id);
+
+/**
+  \brief     count one tick, called from the tick interrupt
+
+  A tick that wakes the core from WFI, or that the idle function counts on
+  its behalf, is counted as idle.
+ */
+void sched_tick();
+
+/**
+  \brief     run pending tasks by priority and sleep with WFI when none is left, never returns
+ */
+void sched_run();
+
+/**
+  \brief     number of ticks counted by sched_tick()
+ */
+uint32_t sched_get_tick_count();
+
+/**
+  \brief     number of ticks that found the core asleep, idle headroom is idle / total
+ */
+uint32_t sched_get_idle_tick_count();
+
+#endif /* APP_SCHED_SCHEDULER_H_ */
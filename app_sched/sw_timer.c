@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "sw_timer.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static sw_timer_t* WHEEL_0[SW_TIMER_SLOTS];
+static sw_timer_t* WHEEL_1[SW_TIMER_SLOTS];
+
+static volatile uint32_t timer_now = 0;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void sw_timer_link(sw_timer_t** head, sw_timer_t* timer)
+{
+    timer->next  = *head;
+    timer->pprev = head;
+    if (*head != NULL)
+    {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+}
+
+static void sw_timer_unlink(sw_timer_t* timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+static void sw_timer_insert(sw_timer_t* timer)
+{
+    uint32_t delta = timer->expiry - timer_now;
+
+    if (delta < SW_TIMER_SLOTS)
+    {
+        sw_timer_link(&WHEEL_0[timer->expiry & SW_TIMER_SLOT_MASK], timer);
+    }
+    else if (delta < (SW_TIMER_SLOTS * SW_TIMER_SLOTS))
+    {
+        sw_timer_link(&WHEEL_1[(timer->expiry >> SW_TIMER_SLOT_BITS) & SW_TIMER_SLOT_MASK], timer);
+    }
+    else
+    {
+        /* Out of range, parked in the level 1 slot cascaded furthest ahead and inserted again from there */
+        sw_timer_link(&WHEEL_1[(timer_now >> SW_TIMER_SLOT_BITS) & SW_TIMER_SLOT_MASK], timer);
+    }
+}
+
+/* Moves a slot to a local list, so that callbacks may start or stop any timer while it is walked */
+static void sw_timer_detach(sw_timer_t** slot, sw_timer_t** list)
+{
+    *list = *slot;
+    *slot = NULL;
+    if (*list != NULL)
+    {
+        (*list)->pprev = list;
+    }
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void sw_timer_init(sw_timer_t* timer, sw_timer_callback_t callback, void* context)
+{
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+    timer->expiry   = 0;
+    timer->period   = 0;
+    timer->callback = callback;
+    timer->context  = context;
+}
+
+void sw_timer_start(sw_timer_t* timer, uint32_t delay, uint32_t period)
+{
+    uint32_t basepri = DisableIRQByPriority(SW_TIMER_IRQ_PRIORITY);
+
+    if (timer->pprev != NULL)
+    {
+        sw_timer_unlink(timer);
+    }
+    timer->expiry = timer_now + ((delay == 0) ? 1U : delay);
+    timer->period = period;
+    sw_timer_insert(timer);
+
+    EnableIRQByPriority(basepri);
+}
+
+void sw_timer_stop(sw_timer_t* timer)
+{
+    uint32_t basepri = DisableIRQByPriority(SW_TIMER_IRQ_PRIORITY);
+
+    if (timer->pprev != NULL)
+    {
+        sw_timer_unlink(timer);
+    }
+
+    EnableIRQByPriority(basepri);
+}
+
+bool sw_timer_is_running(const sw_timer_t* timer)
+{
+    return (timer->pprev != NULL);
+}
+
+void sw_timer_tick()
+{
+    sw_timer_t* list;
+    sw_timer_t* timer;
+    uint32_t now = timer_now + 1U;
+
+    timer_now = now;
+
+    /* Level 0 wrapped, bring the next SW_TIMER_SLOTS ticks down from level 1 */
+    if ((now & SW_TIMER_SLOT_MASK) == 0U)
+    {
+        sw_timer_detach(&WHEEL_1[(now >> SW_TIMER_SLOT_BITS) & SW_TIMER_SLOT_MASK], &list);
+        while (list != NULL)
+        {
+            timer = list;
+            sw_timer_unlink(timer);
+            sw_timer_insert(timer);
+        }
+    }
+
+    sw_timer_detach(&WHEEL_0[now & SW_TIMER_SLOT_MASK], &list);
+    while (list != NULL)
+    {
+        timer = list;
+        sw_timer_unlink(timer);
+        if (timer->expiry != now)
+        {
+            sw_timer_insert(timer);
+            continue;
+        }
+
+        /* Re-armed before the callback, which may stop or restart it */
+        if (timer->period != 0U)
+        {
+            timer->expiry = now + timer->period;
+            sw_timer_insert(timer);
+        }
+        timer->callback(timer);
+    }
+}
+
+uint32_t sw_timer_ticks_to_next(uint32_t limit)
+{
+    uint32_t now = timer_now;
+    uint32_t delta;
+    uint32_t tick;
+
+    /* Every level 0 timer is due within SW_TIMER_SLOTS ticks */
+    for (delta = 1U; (delta <= SW_TIMER_SLOTS) && (delta < limit); delta++)
+    {
+        tick = now + delta;
+        if ((WHEEL_0[tick & SW_TIMER_SLOT_MASK] != NULL)
+                || (((tick & SW_TIMER_SLOT_MASK) == 0U)
+                    && (WHEEL_1[(tick >> SW_TIMER_SLOT_BITS) & SW_TIMER_SLOT_MASK] != NULL)))
+        {
+            return delta;
+        }
+    }
+
+    /* Further on, only the level 1 cascades can have work */
+    for (tick = ((now >> SW_TIMER_SLOT_BITS) + 2U) << SW_TIMER_SLOT_BITS;
+         (tick - now) < limit;
+         tick += SW_TIMER_SLOTS)
+    {
+        if (WHEEL_1[(tick >> SW_TIMER_SLOT_BITS) & SW_TIMER_SLOT_MASK] != NULL)
+        {
+            return tick - now;
+        }
+        if ((tick - now) > (SW_TIMER_SLOTS * (SW_TIMER_SLOTS + 1U)))
+        {
+            break;
+        }
+    }
+
+    return limit;
+}
+
+uint32_t sw_timer_now()
+{
+    return timer_now;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
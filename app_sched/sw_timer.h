@@ -0,0 +1,90 @@
+#ifndef APP_SCHED_SW_TIMER_H_
+#define APP_SCHED_SW_TIMER_H_
+
+#include "driver_common.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*
+ * Two wheels of SW_TIMER_SLOTS slots. Level 0 holds timers due within
+ * SW_TIMER_SLOTS ticks, one tick per slot. Level 1 holds timers due within
+ * SW_TIMER_SLOTS * SW_TIMER_SLOTS ticks, SW_TIMER_SLOTS ticks per slot, and is
+ * cascaded into level 0 each time level 0 wraps. Longer delays are parked in
+ * the level 1 slot visited last and re-inserted until they come into range.
+ */
+#define SW_TIMER_SLOT_BITS      6U
+#define SW_TIMER_SLOTS          (1UL << SW_TIMER_SLOT_BITS)
+#define SW_TIMER_SLOT_MASK      (SW_TIMER_SLOTS - 1U)
+
+/* Priority of the interrupt calling sw_timer_tick(), start and stop mask only this level and below */
+#ifndef SW_TIMER_IRQ_PRIORITY
+#define SW_TIMER_IRQ_PRIORITY   4U
+#endif
+
+typedef struct sw_timer sw_timer_t;
+
+/**
+  \brief     expiry callback, runs in the tick interrupt and must stay short
+  \param [in]    timer : the timer that expired, a periodic timer is already re-armed
+ */
+typedef void (*sw_timer_callback_t)(sw_timer_t* timer);
+
+/* Timer node, owned by the caller and linked into the wheel while running */
+struct sw_timer {
+    sw_timer_t*         next;
+    sw_timer_t**        pprev;      /* link pointing at this node, NULL when stopped */
+    uint32_t            expiry;     /* absolute tick */
+    uint32_t            period;     /* 0 for a one-shot timer */
+    sw_timer_callback_t callback;
+    void*               context;
+};
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         prepare a stopped timer
+  \param [in]    timer : timer to set up
+  \param [in]    callback : function called on expiry
+  \param [in]    context : user data available to the callback
+ */
+void sw_timer_init(sw_timer_t* timer, sw_timer_callback_t callback, void* context);
+
+/**
+  \brief         start or restart a timer, O(1)
+  \param [in]    timer : timer set up by sw_timer_init()
+  \param [in]    delay : ticks until the first expiry, 0 is taken as 1
+  \param [in]    period : ticks between later expiries, 0 for a one-shot timer
+ */
+void sw_timer_start(sw_timer_t* timer, uint32_t delay, uint32_t period);
+
+/**
+  \brief         stop a timer, O(1), nothing happens if it is not running
+ */
+void sw_timer_stop(sw_timer_t* timer);
+
+/**
+  \brief     check if a timer is waiting to expire
+ */
+bool sw_timer_is_running(const sw_timer_t* timer);
+
+/**
+  \brief     advance the wheel by one tick and run the expired callbacks, called from the tick interrupt
+ */
+void sw_timer_tick();
+
+/**
+  \brief         ticks until the wheel has work to do, an expiry or a cascade
+
+  Call with interrupts masked, the answer is only valid until the next start or stop.
+  \param [in]    limit : largest answer wanted
+  \return        number of sw_timer_tick() calls, from 1 to limit, that can pass without running a callback
+ */
+uint32_t sw_timer_ticks_to_next(uint32_t limit);
+
+/**
+  \brief     number of ticks counted by sw_timer_tick()
+ */
+uint32_t sw_timer_now();
+
+#endif /* APP_SCHED_SW_TIMER_H_ */
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "tickless.h"
+#include "scheduler.h"
+#include "sw_timer.h"
+#include "driver_systick.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static LPIT_Type*  tickless_lpit    = NULL;
+static lpit_chnl_t tickless_channel = LPIT_Chnl_0;
+static uint32_t    tickless_clock   = 0;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void tickless_compensate(uint32_t ticks)
+{
+    SysTick_DRV_AddTicks(ticks);
+    while (ticks != 0)
+    {
+        sched_tick();
+        sw_timer_tick();
+        ticks--;
+    }
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void tickless_init(LPIT_Type* base, lpit_chnl_t channel, uint32_t clockHz)
+{
+    lpit_chnl_params_t chnlSetup =
+    {
+        .chainChannel          = false,
+        .timerMode             = LPIT_PeriodicCounter,
+        .triggerSource         = LPIT_TriggerSource_Internal,
+        .enableReloadOnTrigger = false,
+        .enableStopOnTimeout   = true,
+        .enableStartOnTrigger  = false,
+    };
+
+    tickless_lpit    = base;
+    tickless_channel = channel;
+    tickless_clock   = clockHz;
+
+    LPIT_DRV_SetupChannel(base, channel, &chnlSetup);
+    LPIT_DRV_EnableInterrupts(base, LPIT_MIER_TIE0_MASK << (uint32_t)channel);
+}
+
+void tickless_idle()
+{
+    uint32_t ticks = sw_timer_ticks_to_next(TICKLESS_MAX_TICKS);
+    uint32_t period;
+    uint32_t entry;
+    uint32_t value;
+    uint32_t counts;
+    uint32_t elapsed;
+    uint32_t wrapped;
+    int64_t  passed;
+
+    if ((tickless_lpit == NULL) || (ticks < TICKLESS_MIN_TICKS))
+    {
+        __DSB();
+        __WFI();
+        return;
+    }
+
+    /* The counter keeps running, only the tick interrupt stops */
+    S32_SysTick->CSR &= ~S32_SysTick_CSR_TICKINT_MASK;
+    if (0U != (S32_SCB->ICSR & S32_SCB_ICSR_PENDSTSET_MASK))
+    {
+        /* A tick is already due, let the handler count it */
+        S32_SysTick->CSR |= S32_SysTick_CSR_TICKINT_MASK;
+        __DSB();
+        __WFI();
+        return;
+    }
+
+    /* Wake on the reload that ends the last idle tick, value + 1 cycles away from the first */
+    period = S32_SysTick->RVR + 1U;
+    entry  = S32_SysTick->CVR;
+    counts = (uint32_t)((((uint64_t)entry + 1U + ((uint64_t)(ticks - 1U) * period)) * tickless_clock)
+                        / SystemCoreClock);
+
+    tickless_lpit->MSR = LPIT_MSR_TIF0_MASK << (uint32_t)tickless_channel;
+    LPIT_DRV_SetTimerPeriod(tickless_lpit, tickless_channel, counts);
+    LPIT_DRV_StartTimer(tickless_lpit, tickless_channel);
+
+    __DSB();
+    __WFI();
+
+    /* Woken by the deadline or by any other interrupt, still masked */
+    if (0U != (tickless_lpit->MSR & (LPIT_MSR_TIF0_MASK << (uint32_t)tickless_channel)))
+    {
+        elapsed = counts;
+    }
+    else
+    {
+        elapsed = (counts - 1U) - LPIT_DRV_GetCurrentTimerCount(tickless_lpit, tickless_channel);
+    }
+    LPIT_DRV_StopTimer(tickless_lpit, tickless_channel);
+    tickless_lpit->MSR = LPIT_MSR_TIF0_MASK << (uint32_t)tickless_channel;
+
+    /* From here on reloads pend the handler again, as in SysTick_DRV_GetCycles() */
+    S32_SysTick->CSR |= S32_SysTick_CSR_TICKINT_MASK;
+    value   = S32_SysTick->CVR;
+    wrapped = 0U;
+    if (0U != (S32_SCB->ICSR & S32_SCB_ICSR_PENDSTSET_MASK))
+    {
+        value   = S32_SysTick->CVR;
+        wrapped = 1U;
+    }
+
+    /*
+     * The LPIT gives the sleep time to a few cycles, the SysTick counter gives the exact
+     * position within the period, so round to the number of whole reloads between them.
+     */
+    passed = ((int64_t)(period - 1U - entry)
+              + (int64_t)(((uint64_t)elapsed * SystemCoreClock) / tickless_clock)
+              - (int64_t)(period - 1U - value)
+              + (int64_t)(period / 2U)) / (int64_t)period;
+    /* The reload pending now is counted by the handler */
+    passed -= (int64_t)wrapped;
+    if (passed > 0)
+    {
+        tickless_compensate((uint32_t)passed);
+    }
+}
+
+void tickless_irq_handler()
+{
+    if (tickless_lpit != NULL)
+    {
+        tickless_lpit->MSR = LPIT_MSR_TIF0_MASK << (uint32_t)tickless_channel;
+    }
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,44 @@
+#ifndef APP_SCHED_TICKLESS_H_
+#define APP_SCHED_TICKLESS_H_
+
+#include "driver_common.h"
+#include "driver_lpit.h"
+#include "sw_timer.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Shorter idle periods are spent in plain WFI, the reprogramming is not worth it */
+#define TICKLESS_MIN_TICKS      2U
+/* Longest sleep, keeps the LPIT count and the cycle arithmetic in range */
+#define TICKLESS_MAX_TICKS      (SW_TIMER_SLOTS * SW_TIMER_SLOTS)
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         set up an LPIT channel as the one-shot wakeup of tickless idle
+
+  The LPIT module must already be enabled. The SysTick counter keeps running
+  during the sleep so tick boundaries stay aligned, only its interrupt is
+  disabled.
+  \param [in]    base : LPIT peripheral base address
+  \param [in]    channel : spare channel, its interrupt must call tickless_irq_handler()
+  \param [in]    clockHz : LPIT functional clock
+ */
+void tickless_init(LPIT_Type* base, lpit_chnl_t channel, uint32_t clockHz);
+
+/**
+  \brief     scheduler idle function, see sched_set_idle()
+
+  Sleeps until the next software timer deadline or any interrupt, then counts
+  the SysTick periods that passed in the scheduler, the timer wheel and the
+  SysTick time base before interrupts are unmasked.
+ */
+void tickless_idle();
+
+/**
+  \brief     wakeup channel interrupt, clears the timeout flag
+ */
+void tickless_irq_handler();
+
+#endif /* APP_SCHED_TICKLESS_H_ */
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "cobs.h"
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+size_t cobs_encode(const uint8_t* src, size_t length, uint8_t* dst)
+{
+    size_t  read       = 0;
+    size_t  write      = 1;
+    size_t  code_index = 0;
+    uint8_t code       = 1;
+
+    while (read < length)
+    {
+        if (src[read] == 0)
+        {
+            /* Close the block, the zero is carried by its code byte */
+            dst[code_index] = code;
+            code            = 1;
+            code_index      = write++;
+        }
+        else
+        {
+            dst[write++] = src[read];
+            code++;
+            if (code == 0xFF)
+            {
+                /* 254 data bytes, the block ends without an implied zero */
+                dst[code_index] = code;
+                code            = 1;
+                code_index      = write++;
+            }
+        }
+        read++;
+    }
+    dst[code_index] = code;
+
+    return write;
+}
+
+size_t cobs_decode(const uint8_t* src, size_t length, uint8_t* dst)
+{
+    size_t  read  = 0;
+    size_t  write = 0;
+    uint8_t code;
+    uint8_t i;
+
+    while (read < length)
+    {
+        code = src[read];
+        if ((code == 0) || ((read + code) > length))
+        {
+            return 0;
+        }
+        read++;
+
+        for (i = 1; i < code; i++)
+        {
+            if (src[read] == 0)
+            {
+                return 0;
+            }
+            dst[write++] = src[read++];
+        }
+
+        /* Every block but a full one and the last is followed by a zero */
+        if ((code != 0xFF) && (read != length))
+        {
+            dst[write++] = 0;
+        }
+    }
+
+    return write;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,36 @@
+#ifndef APP_UART_COBS_H_
+#define APP_UART_COBS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Worst case size of length bytes once encoded, without the 0x00 delimiter */
+#define COBS_MAX_ENCODED_LENGTH(length)     ((length) + ((length) / 254U) + 1U)
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         Consistent Overhead Byte Stuffing encode
+
+  The output contains no 0x00 byte, so 0x00 can delimit frames on the wire.
+  The delimiter is not written.
+  \param [in]    src : data to encode
+  \param [in]    length : number of bytes in src
+  \param [out]   dst : at least COBS_MAX_ENCODED_LENGTH(length) bytes, must not overlap src
+  \return        number of bytes written to dst
+ */
+size_t cobs_encode(const uint8_t* src, size_t length, uint8_t* dst);
+
+/**
+  \brief         Consistent Overhead Byte Stuffing decode
+  \param [in]    src : encoded bytes, without the 0x00 delimiter
+  \param [in]    length : number of bytes in src
+  \param [out]   dst : at least length bytes, must not overlap src
+  \return        number of bytes written to dst, 0 if src is empty or malformed
+ */
+size_t cobs_decode(const uint8_t* src, size_t length, uint8_t* dst);
+
+#endif /* APP_UART_COBS_H_ */
@@ -0,0 +1,27 @@
+#ifndef APP_UART_CRC_H_
+#define APP_UART_CRC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Integrity checks of the frame formats, no device dependency so they build on a host */
+
+/**
+  \brief     8-bit sum, the legacy frame check
+  \return    sum of the data modulo 256
+ */
+uint8_t sum8_compute(const uint8_t* data, size_t length);
+
+/**
+  \brief     table-driven CRC-8, polynomial 0x07, initial value 0x00
+  \return    CRC of the data
+ */
+uint8_t crc8_compute(const uint8_t* data, size_t length);
+
+/**
+  \brief     table-driven CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF
+  \return    CRC of the data
+ */
+uint16_t crc16_compute(const uint8_t* data, size_t length);
+
+#endif /* APP_UART_CRC_H_ */
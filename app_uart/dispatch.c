@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dispatch.h"
+#include "queue.h"
+#include "trace.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static dispatch_handler_t DISPATCH_HANDLERS[DISPATCH_TABLE_SIZE];
+static uint8_t            DISPATCH_FLAGS[DISPATCH_TABLE_SIZE];
+
+static volatile uint32_t unhandled_count = 0;
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void dispatch_register(uint8_t option, dispatch_handler_t handler, uint8_t flags)
+{
+    DISPATCH_HANDLERS[option] = handler;
+    DISPATCH_FLAGS[option]    = flags;
+}
+
+void dispatch_frame(const uint8_t* frame)
+{
+    uint8_t option = frame[MEASSAGE_OPTION_BYTE];
+    dispatch_handler_t handler = DISPATCH_HANDLERS[option];
+
+    TRACE(TRACE_FRAME_PARSED, option, frame[MEASSAGE_VALUE_BYTE]);
+    if (handler == NULL)
+    {
+        unhandled_count++;
+    }
+    else if (DISPATCH_FLAGS[option] & DISPATCH_FLAG_ISR)
+    {
+        handler(option, frame[MEASSAGE_VALUE_BYTE]);
+    }
+    else
+    {
+        /* A full queue drops the frame, the link stays aligned */
+        (void)queue_put_frame(frame);
+    }
+}
+
+void dispatch_deferred()
+{
+    const uint8_t* frame;
+    dispatch_handler_t handler;
+
+    while ((frame = queue_peek()) != NULL)
+    {
+        /* Looked up again, the handler may have been replaced since the frame was queued */
+        handler = DISPATCH_HANDLERS[frame[MEASSAGE_OPTION_BYTE]];
+        if (handler != NULL)
+        {
+            handler(frame[MEASSAGE_OPTION_BYTE], frame[MEASSAGE_VALUE_BYTE]);
+        }
+        /* The slot is only recycled once the frame was handled */
+        queue_release();
+    }
+}
+
+uint32_t dispatch_get_unhandled_count()
+{
+    return unhandled_count;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
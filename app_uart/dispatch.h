@@ -0,0 +1,57 @@
+#ifndef APP_UART_DISPATCH_H_
+#define APP_UART_DISPATCH_H_
+
+#include "S32K144.h"
+#include "encode.h"
+#include "driver_common.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* One entry per value of the option byte */
+#define DISPATCH_TABLE_SIZE     256U
+
+/* Handler runs in main through dispatch_deferred(), the frame waits in the queue */
+#define DISPATCH_FLAG_DEFERRED  0x00U
+/* Handler runs in the UART interrupt as soon as the frame is validated */
+#define DISPATCH_FLAG_ISR       0x01U
+
+/**
+  \brief     command handler
+  \param [in]    option : option byte of the received frame
+  \param [in]    value : value byte of the received frame
+ */
+typedef void (*dispatch_handler_t)(uint8_t option, uint8_t value);
+
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         register the handler of an option byte, replacing any previous one
+
+  Call before the UART is enabled, the table is read from the interrupt without locking.
+  \param [in]    option : option byte the handler serves
+  \param [in]    handler : function called for each frame, NULL removes the entry
+  \param [in]    flags : DISPATCH_FLAG_ISR or DISPATCH_FLAG_DEFERRED
+ */
+void dispatch_register(uint8_t option, dispatch_handler_t handler, uint8_t flags);
+
+/**
+  \brief         route a validated frame, called by the parser in interrupt context
+
+  ISR handlers run at once. Frames with a deferred handler are put in the queue.
+  Frames with no handler are counted and dropped so they do not take queue slots.
+  \param [in]    frame : MESSAGE_LENGTH bytes of a validated frame
+ */
+void dispatch_frame(const uint8_t* frame);
+
+/**
+  \brief     run the deferred handlers of every queued frame, called from main
+ */
+void dispatch_deferred();
+
+/**
+  \brief     number of validated frames dropped because no handler was registered
+ */
+uint32_t dispatch_get_unhandled_count();
+
+#endif /* APP_UART_DISPATCH_H_ */
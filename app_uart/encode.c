@@ -2,54 +2,137 @@
 #include "encode.h"
 #include "S32K144.h"
 #include "driver_uart.h"
+#include "trace.h"
 
-uint8_t check_message() {
-    if (!is_queue_empty()) {
-        uint8_t* new_message = queue_get_data();
+static encode_integrity_t frame_integrity = INTEGRITY_SUM8;
+static encode_protocol_t  frame_protocol  = PROTOCOL_LEGACY;
 
-        // Check start & stop byte
-        if (new_message[START_BYTE] != START_BYTE_VALUE
-                || new_message[STOP_BYTE] != STOP_BYTE_VALUE) {
-                    return MESSAGE_ERROR;
-                }
+// Records waiting for flush_records(), laid out as a v2 frame before encoding
+static uint8_t batch[V2_MAX_PAYLOAD];
+static uint8_t batch_length = 0;
 
-        // Check sum
-        uint8_t check_sum = 0;
-        for(int i = CHECK_SUM_START; i < CHECK_SUM_STOP; i++) {
-            check_sum += new_message[i];
-        }
+void encode_set_integrity(encode_integrity_t integrity) {
+    frame_integrity = integrity;
+}
 
-        if (check_sum != new_message[CHECK_SUM_INDEX]) {
-            return MESSAGE_ERROR;
-        }
+encode_integrity_t encode_get_integrity() {
+    return frame_integrity;
+}
+
+void encode_set_protocol(encode_protocol_t protocol) {
+    if ((frame_protocol == PROTOCOL_V2) && (protocol != PROTOCOL_V2)) {
+        // A batch left behind would go out on the next switch back to v2
+        (void)flush_records();
+        batch_length = 0;
+    }
+    frame_protocol = protocol;
+}
+
+encode_protocol_t encode_get_protocol() {
+    return frame_protocol;
+}
+
+uint8_t frame_checksum(const uint8_t* frame) {
+    const uint8_t* data = &frame[CHECK_SUM_START];
+    size_t length = CHECK_SUM_STOP - CHECK_SUM_START + 1;
+    uint8_t check_sum = 0;
+
+    switch (frame_integrity) {
+        case INTEGRITY_CRC8:
+            check_sum = crc8_compute(data, length);
+            break;
+        case INTEGRITY_SUM8:
+        default:
+            check_sum = sum8_compute(data, length);
+            break;
+    }
+    return check_sum;
+}
+
+static bool push_legacy_frame(uint8_t option, uint8_t value) {
+    uint8_t frame[MESSAGE_LENGTH];
+
+    frame[START_BYTE]           = START_BYTE_VALUE;
+    frame[MEASSAGE_OPTION_BYTE] = option;
+    frame[MEASSAGE_VALUE_BYTE]  = value;
+    frame[CHECK_SUM_INDEX]      = frame_checksum(frame);
+    frame[STOP_BYTE]            = STOP_BYTE_VALUE;
+
+    // Queue the whole frame for the TX interrupt, never wait for the UART
+    return LPUART_DRV_WriteNonBlocking(LPUART1, frame, MESSAGE_LENGTH);
+}
+
+bool push_message(uint8_t option, uint8_t value) {
+    bool queued;
+
+    if (frame_protocol == PROTOCOL_V2) {
+        queued = push_record(option, &value, 1);
     } else {
-        return MESSAGE_NO_AVALABLE;
+        queued = push_legacy_frame(option, value);
     }
-    return MESSAGE_CORRECT;
+    TRACE(TRACE_PUSH_MESSAGE, option, value | (queued ? 0x000 : 0x100));
+    return queued;
 }
 
-void push_message(uint8_t option, uint8_t value) {
-    LPUART_DRV_WriteByte(LPUART1, START_BYTE_VALUE);
-    LPUART_DRV_WriteByte(LPUART1, option);
-    LPUART_DRV_WriteByte(LPUART1, value);
-    LPUART_DRV_WriteByte(LPUART1, (uint8_t)(option + value));
-    LPUART_DRV_WriteByte(LPUART1, STOP_BYTE_VALUE);
+bool push_record(uint8_t option, const uint8_t* data, uint8_t size) {
+    uint8_t record_length = (uint8_t)(V2_RECORD_HEADER_LENGTH + size);
+
+    if (frame_protocol != PROTOCOL_V2) {
+        return (size == 1) && push_legacy_frame(option, data[0]);
+    }
+
+    if (record_length > V2_MAX_RECORD_BYTES) {
+        return false;
+    }
+
+    if (batch_length + record_length > V2_MAX_RECORD_BYTES) {
+        if (!flush_records()) {
+            return false;
+        }
+    }
+
+    batch[V2_RECORDS_BYTE + batch_length]     = option;
+    batch[V2_RECORDS_BYTE + batch_length + 1] = size;
+    memcpy(&batch[V2_RECORDS_BYTE + batch_length + V2_RECORD_HEADER_LENGTH], data, size);
+    batch_length += record_length;
+    return true;
 }
 
-int checkReceiveCommandValid(uint8_t* cmd) {
+bool flush_records() {
+    uint8_t frame[V2_MAX_FRAME + 1];
+    size_t payload_length = V2_HEADER_LENGTH + batch_length;
+    size_t frame_length;
+    uint16_t crc;
+
+    if (batch_length == 0) {
+        return true;
+    }
+
+    batch[V2_VERSION_BYTE] = V2_VERSION;
+    batch[V2_LENGTH_BYTE]  = batch_length;
+    crc = crc16_compute(batch, payload_length);
+    batch[payload_length]     = (uint8_t)(crc >> 8);
+    batch[payload_length + 1] = (uint8_t)crc;
+
+    frame_length = cobs_encode(batch, payload_length + V2_CRC_LENGTH, frame);
+    frame[frame_length++] = V2_DELIMITER;
+
+    // The batch is kept for the next call if the TX ring cannot take the frame
+    if (!LPUART_DRV_WriteNonBlocking(LPUART1, frame, frame_length)) {
+        return false;
+    }
+    batch_length = 0;
+    return true;
+}
+
+int checkReceiveCommandValid(const uint8_t* cmd) {
     // Check start & stop byte
     if (cmd[START_BYTE] != START_BYTE_VALUE
             || cmd[STOP_BYTE] != STOP_BYTE_VALUE) {
                 return MESSAGE_ERROR;
             }
 
-    // Check sum
-    uint8_t check_sum = 0;
-    for(int i = CHECK_SUM_START; i <= CHECK_SUM_STOP; i++) {
-        check_sum += (uint8_t)cmd[i];
-    }
-
-    if (check_sum != (uint8_t)cmd[CHECK_SUM_INDEX]) {
+    if (frame_checksum(cmd) != cmd[CHECK_SUM_INDEX]) {
         return MESSAGE_ERROR;
     } 
     
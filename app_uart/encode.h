@@ -1,8 +1,11 @@
 #ifndef ENCODE_H
 #define ENCODE_H
 #include "S32K144.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "cobs.h"
+#include "crc.h"
 
-#define BUFFER_SIZE_2D          4
 #define MESSAGE_LENGTH          5
 
 #define START_BYTE 			    0
@@ -29,14 +32,106 @@
 #define OPTION_GO_BACK          '<'
 #define OPTION_PLAYING          'p'
 #define OPTION_PAUSE            't'
+#define OPTION_TRIPLE_CLICK     'k'     /* value is the button, BUTTON_SW2_VALUE or BUTTON_SW3_VALUE */
+#define OPTION_LONG_PRESS       'l'     /* value is the button, BUTTON_SW2_VALUE or BUTTON_SW3_VALUE */
+#define OPTION_PROFILE          'h'     /* value PROFILE_CMD_*, replies are v2 records, PROFILE_REPLY_NEED_V2 in legacy */
+#define OPTION_TRACE            'x'     /* value TRACE_CMD_*, replies are v2 records, TRACE_REPLY_NEED_V2 in legacy */
+#define OPTION_PROTOCOL         'w'     /* value PROTOCOL_CMD_*, echoed back in the new wire format */
 
 #define MESSAGE_DEFAULT_VALUE           '0'
+#define BUTTON_SW2_VALUE                '2'
+#define BUTTON_SW3_VALUE                '3'
 
-// #define 
-uint8_t check_message();
+/*
+ * Values of OPTION_PROTOCOL. The command is sent in the format in use and the
+ * echo comes back in the new one, the host waits for it before switching.
+ * PROTOCOL_CMD_LEGACY always leads back to the power-on format.
+ */
+#define PROTOCOL_CMD_LEGACY             '0'     /* legacy frames, 8-bit sum */
+#define PROTOCOL_CMD_LEGACY_CRC8        '1'     /* legacy frames, CRC-8 */
+#define PROTOCOL_CMD_V2                 '2'     /* v2 COBS frames, CRC-16 */
 
-void push_message(uint8_t option, uint8_t value);
+/*
+ * Protocol v2 frame, before COBS encoding:
+ *   V2_VERSION | LEN | records | CRC-16 high | CRC-16 low
+ * LEN is the number of record bytes, each record is option | size | size data bytes.
+ * The CRC-16/CCITT-FALSE covers VERSION to the last record byte. The COBS encoded
+ * frame is followed by V2_DELIMITER, the only 0x00 byte on the wire.
+ */
+#define V2_VERSION              0x02
+#define V2_DELIMITER            0x00
+#define V2_VERSION_BYTE         0
+#define V2_LENGTH_BYTE          1
+#define V2_RECORDS_BYTE         2
+#define V2_HEADER_LENGTH        2
+#define V2_CRC_LENGTH           2
+#define V2_RECORD_HEADER_LENGTH 2
+#define V2_MAX_RECORD_BYTES     32
+#define V2_MAX_PAYLOAD          (V2_HEADER_LENGTH + V2_MAX_RECORD_BYTES + V2_CRC_LENGTH)
+#define V2_MAX_FRAME            COBS_MAX_ENCODED_LENGTH(V2_MAX_PAYLOAD)
 
-int checkReceiveCommandValid(uint8_t* cmd);
+/* Wire format used by push_message() and the receive side, both ends must agree */
+typedef enum {
+    PROTOCOL_LEGACY = 0,    /* fixed MESSAGE_LENGTH frames, one byte of payload */
+    PROTOCOL_V2     = 1,    /* COBS framed batches of records */
+} encode_protocol_t;
+
+/* Integrity check carried in CHECK_SUM_INDEX, both ends must agree */
+typedef enum {
+    INTEGRITY_SUM8  = 0,    /* 8-bit sum of the checked bytes (legacy) */
+    INTEGRITY_CRC8  = 1,    /* CRC-8, polynomial 0x07 */
+} encode_integrity_t;
+
+/**
+  \brief     select the integrity check used by push_message() and the receive side
+ */
+void encode_set_integrity(encode_integrity_t integrity);
+
+/**
+  \brief     get the integrity check in use
+ */
+encode_integrity_t encode_get_integrity();
+
+/**
+  \brief     integrity check of bytes CHECK_SUM_START to CHECK_SUM_STOP inclusive
+  \return    value expected at CHECK_SUM_INDEX
+ */
+uint8_t frame_checksum(const uint8_t* frame);
+
+/**
+  \brief     select the wire format, the parser follows the change on its next byte
+
+  Records still batched when leaving PROTOCOL_V2 are flushed first, or dropped
+  if the TX ring cannot take them.
+ */
+void encode_set_protocol(encode_protocol_t protocol);
+
+/**
+  \brief     get the wire format in use
+ */
+encode_protocol_t encode_get_protocol();
+
+/**
+  \brief     queue a frame for transmission without waiting for the UART
+  \return    true if the frame was queued, false if the TX ring is full
+ */
+bool push_message(uint8_t option, uint8_t value);
+
+/**
+  \brief     add a record to the v2 batch, sent by flush_records()
+
+  A batch that cannot take the record is flushed first. In legacy mode only
+  one byte records can be sent and they go out as a frame at once.
+  \return    true if the record was accepted, false if it is too long or the TX ring is full
+ */
+bool push_record(uint8_t option, const uint8_t* data, uint8_t size);
+
+/**
+  \brief     send the v2 batch as one COBS frame
+  \return    true if the batch is empty or was queued, false if the TX ring is full
+ */
+bool flush_records();
+
+int checkReceiveCommandValid(const uint8_t* cmd);
 
 #endif
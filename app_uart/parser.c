@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "parser.h"
+#include "dispatch.h"
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+static uint8_t  PARSER_FRAME[MESSAGE_LENGTH];
+static uint8_t  parser_count         = 0;
+static bool     parser_hunting       = false;
+
+static uint8_t  PARSER_V2_FRAME[V2_MAX_FRAME];
+static uint8_t  parser_v2_count      = 0;
+static bool     parser_v2_overflow   = false;
+static encode_protocol_t parser_protocol = PROTOCOL_LEGACY;
+
+static volatile uint32_t sync_loss_count      = 0;
+static volatile uint32_t checksum_error_count = 0;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static void parser_resync()
+{
+    uint8_t start = 1;
+
+    /* Restart from the next start byte already received, if any */
+    while ((start < parser_count) && (PARSER_FRAME[start] != START_BYTE_VALUE))
+    {
+        start++;
+    }
+    parser_count -= start;
+    memmove(PARSER_FRAME, &PARSER_FRAME[start], parser_count);
+    /* Bytes skipped from here on belong to the error just counted */
+    parser_hunting = (parser_count == 0);
+}
+
+static void parser_v2_frame()
+{
+    uint8_t payload[V2_MAX_FRAME];
+    uint8_t frame[MESSAGE_LENGTH];
+    size_t  length;
+    size_t  index;
+    uint16_t crc;
+
+    length = cobs_decode(PARSER_V2_FRAME, parser_v2_count, payload);
+    if ((length < (V2_HEADER_LENGTH + V2_CRC_LENGTH))
+            || (payload[V2_VERSION_BYTE] != V2_VERSION)
+            || ((V2_HEADER_LENGTH + payload[V2_LENGTH_BYTE] + V2_CRC_LENGTH) != length))
+    {
+        sync_loss_count++;
+        return;
+    }
+
+    length -= V2_CRC_LENGTH;
+    crc = (uint16_t)((payload[length] << 8) | payload[length + 1]);
+    if (crc16_compute(payload, length) != crc)
+    {
+        checksum_error_count++;
+        return;
+    }
+
+    /* Records carrying one byte are handed on as legacy frames, others are skipped */
+    index = V2_RECORDS_BYTE;
+    while ((index + V2_RECORD_HEADER_LENGTH) <= length)
+    {
+        if ((index + V2_RECORD_HEADER_LENGTH + payload[index + 1]) > length)
+        {
+            sync_loss_count++;
+            return;
+        }
+        if (payload[index + 1] == 1)
+        {
+            frame[START_BYTE]           = START_BYTE_VALUE;
+            frame[MEASSAGE_OPTION_BYTE] = payload[index];
+            frame[MEASSAGE_VALUE_BYTE]  = payload[index + V2_RECORD_HEADER_LENGTH];
+            frame[CHECK_SUM_INDEX]      = frame_checksum(frame);
+            frame[STOP_BYTE]            = STOP_BYTE_VALUE;
+            dispatch_frame(frame);
+        }
+        index += V2_RECORD_HEADER_LENGTH + payload[index + 1];
+    }
+}
+
+static void parser_v2_put_byte(const uint8_t data)
+{
+    if (data == V2_DELIMITER)
+    {
+        /* Empty frames between delimiters are padding, not errors */
+        if (!parser_v2_overflow && (parser_v2_count != 0))
+        {
+            parser_v2_frame();
+        }
+        parser_v2_count    = 0;
+        parser_v2_overflow = false;
+        return;
+    }
+
+    if (parser_v2_count < V2_MAX_FRAME)
+    {
+        PARSER_V2_FRAME[parser_v2_count] = data;
+        parser_v2_count++;
+    }
+    else if (!parser_v2_overflow)
+    {
+        /* Drop bytes up to the next delimiter, count the frame once */
+        parser_v2_overflow = true;
+        sync_loss_count++;
+    }
+}
+
+/******************************************************************************
+ * Public functions
+ ******************************************************************************/
+void parser_put_byte(const uint8_t data)
+{
+    encode_protocol_t protocol = encode_get_protocol();
+
+    if (protocol != parser_protocol)
+    {
+        /* A partial frame of the other format is meaningless now */
+        parser_protocol    = protocol;
+        parser_count       = 0;
+        parser_hunting     = false;
+        parser_v2_count    = 0;
+        parser_v2_overflow = false;
+    }
+
+    if (protocol == PROTOCOL_V2)
+    {
+        parser_v2_put_byte(data);
+        return;
+    }
+
+    if (parser_count == 0)
+    {
+        /* Hunt for the start byte, count each skipped run once */
+        if (data != START_BYTE_VALUE)
+        {
+            if (!parser_hunting)
+            {
+                parser_hunting = true;
+                sync_loss_count++;
+            }
+            return;
+        }
+        parser_hunting = false;
+    }
+
+    PARSER_FRAME[parser_count] = data;
+    parser_count++;
+    if (parser_count < MESSAGE_LENGTH)
+    {
+        return;
+    }
+
+    if (PARSER_FRAME[STOP_BYTE] != STOP_BYTE_VALUE)
+    {
+        sync_loss_count++;
+        parser_resync();
+    }
+    else if (frame_checksum(PARSER_FRAME) != PARSER_FRAME[CHECK_SUM_INDEX])
+    {
+        checksum_error_count++;
+        parser_resync();
+    }
+    else
+    {
+        dispatch_frame(PARSER_FRAME);
+        parser_count = 0;
+    }
+}
+
+uint32_t parser_get_sync_loss_count()
+{
+    return sync_loss_count;
+}
+
+uint32_t parser_get_checksum_error_count()
+{
+    return checksum_error_count;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
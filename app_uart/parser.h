@@ -0,0 +1,38 @@
+#ifndef APP_UART_PARSER_H_
+#define APP_UART_PARSER_H_
+
+#include "S32K144.h"
+#include "encode.h"
+#include "driver_common.h"
+/******************************************************************************
+ * Public fucntions
+ ******************************************************************************/
+/**
+  \brief         feed one received byte to the frame parser
+
+  The parser hunts for START_BYTE_VALUE, collects MESSAGE_LENGTH bytes and checks
+  the stop byte and checksum. Only valid frames are passed to dispatch_frame(). On a bad
+  frame it restarts from the next start byte already received, so the stream
+  is re-aligned within one frame.
+
+  With PROTOCOL_V2 selected, bytes are collected up to V2_DELIMITER, COBS
+  decoded and checked against the version, length and CRC-16. Each one byte
+  record is dispatched as a legacy frame.
+  \param [in]    data : byte received from UART
+ */
+void parser_put_byte(const uint8_t data);
+
+/**
+  \brief     number of times the parser lost frame alignment
+  \return    frames dropped for a bad stop byte plus runs of bytes skipped while hunting,
+             in v2 mode frames that are too long, badly encoded or have a bad header
+ */
+uint32_t parser_get_sync_loss_count();
+
+/**
+  \brief     number of aligned frames dropped for a bad checksum or CRC-16
+  \return    checksum error count
+ */
+uint32_t parser_get_checksum_error_count();
+
+#endif /* APP_UART_PARSER_H_ */
@@ -7,31 +7,32 @@
 /******************************************************************************
  * Definitions
  ******************************************************************************/
-
-struct queue
-{
-	uint8_t(*buffer)[MESSAGE_LENGTH];    /* Pointer to queue buffer */
-	uint8_t  size_1D;                    /* Size of 1st dimension of queue */
-	uint8_t  size_2D;                    /* Size of 2nd dimension of queue */
-	uint8_t  head_1D;                    /* Head pointer of 1st dimension */
-	uint8_t  head_2D;                    /* Head pointer of 2nd dimension */
-	uint8_t  tail;                       /* Tail pointer */
-};
+/* Number of received frames the queue holds, must be a power of two */
+#define QUEUE_DEPTH             8U
 
 /******************************************************************************
  * Public fucntions
  ******************************************************************************/
 /**
-  \brief         take a charater from UART, put in in queue buffer, move head pt
-  \param [in]    data : data of a character from UART
+  \brief         copy a complete frame in queue buffer, move head pointer
+  \param [in]    frame : MESSAGE_LENGTH bytes of a validated frame
+  \return        true if the frame was queued, false if the queue is full
+ */
+bool queue_put_frame(const uint8_t *frame);
+
+/**
+  \brief     lend the oldest frame in place, the tail pointer does not move
+
+  The slot cannot be overwritten by the UART interrupt until queue_release()
+  is called, so the frame can be read without copying it.
+  \return    pointer to the oldest frame, NULL if the queue is empty
  */
-void queue_put_data(const uint8_t data);
+const uint8_t* queue_peek();
 
 /**
-  \brief     take out a array from queue buffer, move tail pointer
-  \return    pointer to a array queue buffer
+  \brief     give back the frame lent by queue_peek(), move tail pointer
  */
-uint8_t* queue_get_data();
+void queue_release();
 
 /**
   \brief     check if queue is empty
@@ -45,8 +46,6 @@ bool is_queue_empty();
  */
 bool is_queue_full();
 
-uint8_t check_message();
-
-void push_message(uint8_t option, uint8_t value);
+bool push_message(uint8_t option, uint8_t value);
 
 #endif /* HAL_QUEUE_QUEUE_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Host microbenchmark of the frame integrity checks in crc.c.
+ *
+ * Build and run from the repository root:
+ *   gcc -O2 -I app_uart app_uart/test/crc_bench.c app_uart/crc.c -o crc_bench && ./crc_bench
+ *
+ * Checks the known CRC answers first and exits with 1 if one is wrong. Then reports the
+ * bytes per cycle of each check over the frame lengths in use. On x86 the cycles are the
+ * time stamp counter. Elsewhere they are derived from the wall clock and BENCH_CPU_HZ.
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "crc.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Clock used to turn nanoseconds into cycles where there is no cycle counter */
+#ifndef BENCH_CPU_HZ
+#define BENCH_CPU_HZ        1000000000ULL
+#endif
+
+#define BENCH_BYTES         (1UL << 22)     /* bytes checked per measurement */
+#define BENCH_RUNS          7U              /* the fastest run is reported */
+#define BENCH_MAX_LENGTH    256U
+
+typedef uint32_t (*bench_check_t)(const uint8_t* data, size_t length);
+
+typedef struct {
+    const char*   name;
+    bench_check_t check;
+} bench_variant_t;
+
+/******************************************************************************
+ * Global variables
+ ******************************************************************************/
+/* Legacy checked bytes, a short and a full v2 payload, then longer blocks for reference */
+static const size_t BENCH_LENGTHS[] = { 3U, 8U, 36U, 64U, BENCH_MAX_LENGTH };
+
+static uint8_t bench_data[BENCH_MAX_LENGTH];
+/* Keeps the compiler from dropping the checks */
+static volatile uint32_t bench_sink;
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+static uint32_t bench_sum8(const uint8_t* data, size_t length)
+{
+    return sum8_compute(data, length);
+}
+
+static uint32_t bench_crc8(const uint8_t* data, size_t length)
+{
+    return crc8_compute(data, length);
+}
+
+static uint32_t bench_crc16(const uint8_t* data, size_t length)
+{
+    return crc16_compute(data, length);
+}
+
+static const bench_variant_t BENCH_VARIANTS[] = {
+    { "SUM8",   bench_sum8 },
+    { "CRC-8",  bench_crc8 },
+    { "CRC-16", bench_crc16 },
+};
+
+static uint64_t bench_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec) * BENCH_CPU_HZ
+           / 1000000000ULL;
+#endif
+}
+
+static int bench_known_answers()
+{
+    static const uint8_t check[] = "123456789";
+    uint8_t  crc8  = crc8_compute(check, sizeof(check) - 1U);
+    uint16_t crc16 = crc16_compute(check, sizeof(check) - 1U);
+    int      failed = 0;
+
+    printf("CRC-8  \"123456789\" = 0x%02X, expected 0xF4\n", crc8);
+    printf("CRC-16 \"123456789\" = 0x%04X, expected 0x29B1\n", crc16);
+    if (crc8 != 0xF4U)
+    {
+        failed = 1;
+    }
+    if (crc16 != 0x29B1U)
+    {
+        failed = 1;
+    }
+    return failed;
+}
+
+/* Bytes per cycle of one check over frames of length bytes, best of BENCH_RUNS */
+static double bench_measure(bench_check_t check, size_t length)
+{
+    size_t   frames = BENCH_BYTES / length;
+    uint64_t best   = UINT64_MAX;
+    uint64_t start;
+    uint64_t cycles;
+    uint32_t acc;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        acc   = 0;
+        start = bench_cycles();
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            /* The first byte changes so that every call has to be made */
+            bench_data[0] = (uint8_t)frame;
+            acc += check(bench_data, length);
+        }
+        cycles = bench_cycles() - start;
+        bench_sink = acc;
+        if (cycles < best)
+        {
+            best = cycles;
+        }
+    }
+    return (double)(frames * length) / (double)((best != 0U) ? best : 1U);
+}
+
+/******************************************************************************
+ * Main
+ ******************************************************************************/
+int main(void)
+{
+    if (bench_known_answers() != 0)
+    {
+        printf("known answer check failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(bench_data); i++)
+    {
+        bench_data[i] = (uint8_t)((i * 131U) + 7U);
+    }
+
+    printf("\n%-8s", "bytes");
+    for (size_t v = 0; v < sizeof(BENCH_VARIANTS) / sizeof(BENCH_VARIANTS[0]); v++)
+    {
+        printf("%12s", BENCH_VARIANTS[v].name);
+    }
+    printf("   (bytes/cycle)\n");
+
+    for (size_t l = 0; l < sizeof(BENCH_LENGTHS) / sizeof(BENCH_LENGTHS[0]); l++)
+    {
+        printf("%-8zu", BENCH_LENGTHS[l]);
+        for (size_t v = 0; v < sizeof(BENCH_VARIANTS) / sizeof(BENCH_VARIANTS[0]); v++)
+        {
+            printf("%12.3f", bench_measure(BENCH_VARIANTS[v].check, BENCH_LENGTHS[l]));
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -37,11 +37,15 @@ void ADC_DRV_Init(ADC_Type *base, const adc_config_t *config)
     base->SC2 = tmp32;
 
     /* ADCx_SC3. */
-    tmp32 = (base->SC3 & ~ADC_SC3_ADCO_MASK);
+    tmp32 = (base->SC3 & ~(ADC_SC3_ADCO_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK));
     if (true == config->enableContinuousConversion)
     {
         tmp32 |= ADC_SC3_ADCO_MASK;
     }
+    if (ADC_HardwareAverageDisabled != config->hardwareAverage)
+    {
+        tmp32 |= ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(config->hardwareAverage - 1U);
+    }
     base->SC3 = tmp32;
 }
 
@@ -62,6 +66,57 @@ void ADC_DRV_SetChannelConfig(ADC_Type *base, uint32_t channelGroup,
     base->SC1[channelGroup] = tmp32;
 }
 
+void ADC_DRV_SetHardwareCompareConfig(ADC_Type *base,
+                                      const adc_hardware_compare_config_t *config)
+{
+    uint32_t tmp32;
+
+    /* ADCx_SC2. */
+    tmp32 = (base->SC2 & ~(ADC_SC2_ACFE_MASK | ADC_SC2_ACFGT_MASK | ADC_SC2_ACREN_MASK));
+    if (NULL == config)
+    {
+        base->SC2 = tmp32;
+        return;
+    }
+    assert((config->mode < ADC_HardwareCompareOutsideRange) || (config->value1 <= config->value2));
+
+    /* ADCx_CVn, CV1 <= CV2 selects the range outside or inside, ACFGT the inclusive bounds */
+    base->CV[0] = config->value1;
+    base->CV[1] = config->value2;
+    tmp32 |= ADC_SC2_ACFE_MASK;
+    switch (config->mode)
+    {
+        case ADC_HardwareCompareLessThan:
+            break;
+        case ADC_HardwareCompareGreaterOrEqual:
+            tmp32 |= ADC_SC2_ACFGT_MASK;
+            break;
+        case ADC_HardwareCompareOutsideRange:
+            tmp32 |= ADC_SC2_ACREN_MASK;
+            break;
+        case ADC_HardwareCompareInsideRange:
+            tmp32 |= ADC_SC2_ACREN_MASK | ADC_SC2_ACFGT_MASK;
+            break;
+        default:
+            /* Nothing */
+            break;
+    }
+    base->SC2 = tmp32;
+}
+
+void ADC_DRV_SetScanConfig(ADC_Type *base, const adc_channel_config_t *configs,
+                           uint32_t count)
+{
+    assert(configs);
+    assert(count <= ADC_SC1_COUNT);
+    uint32_t group;
+
+    for (group = 0U; group < count; group++)
+    {
+        ADC_DRV_SetChannelConfig(base, group, &configs[group]);
+    }
+}
+
 /******************************************************************************
  * EOF
  ******************************************************************************/
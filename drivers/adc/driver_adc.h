@@ -51,6 +51,33 @@ typedef enum _adc_trigger_type
     ADC_TriggerTypeHardware = 1U, /* Hardware trigger selected. */
 } adc_trigger_type_t;
 
+/* @brief Hardware averaging, each result is the mean of several conversions. */
+typedef enum _adc_hardware_average
+{
+    ADC_HardwareAverageDisabled = 0U, /* One conversion per result. */
+    ADC_HardwareAverageCount4   = 1U, /* Mean of 4 conversions. */
+    ADC_HardwareAverageCount8   = 2U, /* Mean of 8 conversions. */
+    ADC_HardwareAverageCount16  = 3U, /* Mean of 16 conversions. */
+    ADC_HardwareAverageCount32  = 4U, /* Mean of 32 conversions. */
+} adc_hardware_average_t;
+
+/* @brief Hardware compare condition, a result failing it is discarded without setting COCO. */
+typedef enum _adc_hardware_compare_mode
+{
+    ADC_HardwareCompareLessThan       = 0U, /* result < value1. */
+    ADC_HardwareCompareGreaterOrEqual = 1U, /* result >= value1. */
+    ADC_HardwareCompareOutsideRange   = 2U, /* result < value1 or result > value2. */
+    ADC_HardwareCompareInsideRange    = 3U, /* value1 <= result <= value2. */
+} adc_hardware_compare_mode_t;
+
+/* @brief Hardware compare configuration, shared by every channel group. */
+typedef struct _adc_hardware_compare_config
+{
+    adc_hardware_compare_mode_t mode;   /* Condition a result must meet to be kept. */
+    uint16_t value1;                    /* CV1, lower bound of the range modes. */
+    uint16_t value2;                    /* CV2, upper bound of the range modes, not below value1. */
+} adc_hardware_compare_config_t;
+
 /* @brief Converter configuration. */
 typedef struct _adc_config
 {
@@ -62,6 +89,7 @@ typedef struct _adc_config
     bool enableContinuousConversion;                        /* Enable continuous conversion mode. */
     adc_trigger_type_t triggerType;                         /* Select the conversion trigger type */
     bool dmaEnable;                                         /* Enable DMA  */
+    adc_hardware_average_t hardwareAverage;                 /* Conversions averaged per result, per trigger */
 } adc_config_t;
 
 /* @brief Channel conversion configuration. */
@@ -96,6 +124,31 @@ void ADC_DRV_Init(ADC_Type *base, const adc_config_t *config);
 void ADC_DRV_SetChannelConfig(ADC_Type *base, uint32_t channelGroup,
                              const adc_channel_config_t *config);
 
+/**
+ * @brief Configure consecutive channel groups for a scan.
+ *
+ * Group n converts configs[n]. With hardware triggers each group has its own pre-trigger,
+ * triggers arriving together are latched and converted in group order.
+ *
+ * @param base     ADC peripheral base address.
+ * @param configs  Array of "adc_channel_config_t", one per group from group 0.
+ * @param count    Number of groups.
+ */
+void ADC_DRV_SetScanConfig(ADC_Type *base, const adc_channel_config_t *configs,
+                           uint32_t count);
+
+/**
+ * @brief Configure the hardware compare function.
+ *
+ * A result failing the condition is not stored, sets no COCO flag and raises neither the
+ * conversion interrupt nor the DMA request. The compare applies to every channel group.
+ *
+ * @param base    ADC peripheral base address.
+ * @param config  Pointer to "adc_hardware_compare_config_t" structure, NULL disables the compare.
+ */
+void ADC_DRV_SetHardwareCompareConfig(ADC_Type *base,
+                                      const adc_hardware_compare_config_t *config);
+
 /**
  * @brief Get the conversion value.
  *
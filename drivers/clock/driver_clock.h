@@ -9,6 +9,9 @@
 /******************************************************************************
  * Definitions
  ******************************************************************************/
+/* @brief Fast IRC frequency. */
+#define CLOCK_FIRC_FREQ_HZ  48000000U
+
 /* @brief Peripheral clock name definition. */
 typedef enum _clock_ip_name
 {
@@ -140,6 +143,49 @@ CLOCK_DRV_SetFircAsyncClkDiv(scg_async_clk_t asyncClk, scg_async_clk_div_t divid
     SCG->FIRCDIV = reg;
 }
 
+/**
+ * @brief Get the frequency of a FIRC asynchronous clock.
+ *
+ * @param asyncClk  Which asynchronous clock to read.
+ * @return Frequency in Hz, 0 if the output is disabled.
+ */
+static inline uint32_t CLOCK_DRV_GetFircAsyncFreq(scg_async_clk_t asyncClk)
+{
+    uint32_t divider;
+
+    if (SCG_AsyncDiv1Clk == asyncClk)
+    {
+        divider = (SCG->FIRCDIV & SCG_FIRCDIV_FIRCDIV1_MASK) >> SCG_FIRCDIV_FIRCDIV1_SHIFT;
+    }
+    else
+    {
+        divider = (SCG->FIRCDIV & SCG_FIRCDIV_FIRCDIV2_MASK) >> SCG_FIRCDIV_FIRCDIV2_SHIFT;
+    }
+
+    return (SCG_AsyncClkDisable == divider) ? 0U : (CLOCK_FIRC_FREQ_HZ >> (divider - 1U));
+}
+
+/**
+ * @brief Get the functional clock frequency of a peripheral.
+ *
+ * Peripherals are clocked by the DIV2 output of their asynchronous source. Only the
+ * FIRC source is brought up by this code, any other source reads as unknown.
+ *
+ * @param name  Which peripheral to check, see \ref clock_ip_name_t.
+ * @return Frequency in Hz, 0 if the clock is off or its source unknown.
+ */
+static inline uint32_t CLOCK_DRV_GetIpFreq(clock_ip_name_t name)
+{
+    uint32_t src = (PCC->PCCn[name] & PCC_PCCn_PCS_MASK) >> PCC_PCCn_PCS_SHIFT;
+
+    if ((0U == (PCC->PCCn[name] & PCC_PCCn_CGC_MASK)) || (CLOCK_IpSrcFircAsync != src))
+    {
+        return 0U;
+    }
+
+    return CLOCK_DRV_GetFircAsyncFreq(SCG_AsyncDiv2Clk);
+}
+
 #endif /* DRIVERS_DRIVER_CLOCK_H_ */
 
 /******************************************************************************
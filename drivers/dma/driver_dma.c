@@ -13,43 +13,65 @@
 void DMA_DRV_SetChannelConfig(DMA_Type * base, uint32_t channel,
                               const dma_channel_config_t *config)
 {
+    assert(NULL != config);
+    assert(0U < config->majorLoopCount);
+
     /* Source Address */
     base->TCD[channel].SADDR = DMA_TCD_SADDR_SADDR(config->srcAddr);
-    /* Source offset = 0 */
-    base->TCD[channel].SOFF = DMA_TCD_SOFF_SOFF(0);
-    /* ATTR: source and destination size */
-    base->TCD[channel].ATTR = DMA_TCD_ATTR_SMOD(0)                        |
+    /* Source offset */
+    base->TCD[channel].SOFF = DMA_TCD_SOFF_SOFF(config->srcOffset);
+    /* ATTR: source and destination size, modulo to wrap inside a buffer aligned to its size */
+    base->TCD[channel].ATTR = DMA_TCD_ATTR_SMOD(config->srcModulo)        |
                               DMA_TCD_ATTR_SSIZE(config->srcTransferSize) |
-                              DMA_TCD_ATTR_DMOD(0)                        |
+                              DMA_TCD_ATTR_DMOD(config->destModulo)       |
                               DMA_TCD_ATTR_DSIZE(config->destTransferSize);
-    /* Minor Byte Transfer Count is 4-bytes */
-    base->TCD[channel].NBYTES.MLOFFNO = DMA_TCD_NBYTES_MLNO_NBYTES(4);
-    /* Last Source Address Adjustment is -0 */
-    base->TCD[channel].SLAST = DMA_TCD_SLAST_SLAST(0);
+    /* Minor Byte Transfer Count */
+    base->TCD[channel].NBYTES.MLOFFNO = DMA_TCD_NBYTES_MLNO_NBYTES(config->minorLoopBytes);
+    /* Last Source Address Adjustment */
+    base->TCD[channel].SLAST = DMA_TCD_SLAST_SLAST(config->srcLastAdjust);
     /* Destination Address of Buffer */
     base->TCD[channel].DADDR = DMA_TCD_DADDR_DADDR(config->destAddr);
-    /* Destination Address Signed Offset is 0 */
-    base->TCD[channel].DOFF = DMA_TCD_DOFF_DOFF(0);
-    /* Current Major Iteration Count is 4, channel-to-channel linking disabled*/
-    base->TCD[channel].CITER.ELINKNO = DMA_TCD_CITER_ELINKNO_CITER(4) |
+    /* Destination Address Signed Offset */
+    base->TCD[channel].DOFF = DMA_TCD_DOFF_DOFF(config->destOffset);
+    /* Current Major Iteration Count, channel-to-channel linking disabled*/
+    base->TCD[channel].CITER.ELINKNO = DMA_TCD_CITER_ELINKNO_CITER(config->majorLoopCount) |
                                        DMA_TCD_CITER_ELINKNO_ELINK(0);
-    /* Destination last address adjustment is -0 */
-    base->TCD[channel].DLASTSGA = DMA_TCD_DLASTSGA_DLASTSGA(0);
-    /* Starting major iteration count is 4, minor channel-to-channel linking disabled */
-    base->TCD[channel].BITER.ELINKNO = DMA_TCD_BITER_ELINKNO_BITER(4) |
+    /* Destination last address adjustment */
+    base->TCD[channel].DLASTSGA = DMA_TCD_DLASTSGA_DLASTSGA(config->destLastAdjust);
+    /* Starting major iteration count, minor channel-to-channel linking disabled */
+    base->TCD[channel].BITER.ELINKNO = DMA_TCD_BITER_ELINKNO_BITER(config->majorLoopCount) |
                                        DMA_TCD_BITER_ELINKNO_ELINK(0);
-    /* Clear CSR */
+    /* CSR: the channel keeps running after the major loop */
     base->TCD[channel].CSR = DMA_TCD_CSR_BWC(0)         |
-                             DMA_TCD_CSR_MAJORELINK(0)  |
-                             DMA_TCD_CSR_MAJORLINKCH(0) |
+                             DMA_TCD_CSR_MAJORELINK(config->enableMajorLink)   |
+                             DMA_TCD_CSR_MAJORLINKCH(config->majorLinkChannel) |
                              DMA_TCD_CSR_ESG(0)         |
                              DMA_TCD_CSR_DREQ(0)        |
-                             DMA_TCD_CSR_INTHALF(0)     |
-                             DMA_TCD_CSR_INTMAJOR(0)    |
+                             DMA_TCD_CSR_INTHALF(config->enableHalfInterrupt)   |
+                             DMA_TCD_CSR_INTMAJOR(config->enableMajorInterrupt) |
                              DMA_TCD_CSR_START(0);
     /* Enable channel HW trigger */
     base->SERQ = channel;
 }
+
+void DMA_DRV_InstallTCD(DMA_Type * base, uint32_t channel, const dma_tcd_t *tcd)
+{
+    assert(NULL != tcd);
+
+    /* Clear CSR first so a stale ESG/DONE cannot act on a half-written TCD */
+    base->TCD[channel].CSR             = 0U;
+    base->TCD[channel].SADDR           = tcd->SADDR;
+    base->TCD[channel].SOFF            = (uint16_t)tcd->SOFF;
+    base->TCD[channel].ATTR            = tcd->ATTR;
+    base->TCD[channel].NBYTES.MLOFFNO  = tcd->NBYTES;
+    base->TCD[channel].SLAST           = (uint32_t)tcd->SLAST;
+    base->TCD[channel].DADDR           = tcd->DADDR;
+    base->TCD[channel].DOFF            = (uint16_t)tcd->DOFF;
+    base->TCD[channel].CITER.ELINKNO   = tcd->CITER;
+    base->TCD[channel].DLASTSGA        = (uint32_t)tcd->DLASTSGA;
+    base->TCD[channel].BITER.ELINKNO   = tcd->BITER;
+    base->TCD[channel].CSR             = tcd->CSR;
+}
 /******************************************************************************
  * EOF
  ******************************************************************************/
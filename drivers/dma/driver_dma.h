@@ -23,8 +23,41 @@ typedef struct _dma_channel_config
     uint32_t destAddr;                                /*!< Memory address pointing to the destination data. */
     edma_transfer_size_t srcTransferSize;             /*!< Source data transfer size. */
     edma_transfer_size_t destTransferSize;            /*!< Destination data transfer size. */
+    int16_t srcOffset;                                /*!< Source address offset after each read. */
+    int16_t destOffset;                               /*!< Destination address offset after each write. */
+    uint32_t minorLoopBytes;                          /*!< Bytes moved per DMA request. */
+    uint16_t majorLoopCount;                          /*!< Minor loops per major loop. */
+    int32_t srcLastAdjust;                            /*!< Source address adjustment after the major loop. */
+    int32_t destLastAdjust;                           /*!< Destination address adjustment after the major loop. */
+    uint8_t srcModulo;                                /*!< Low source address bits allowed to change, 0 disables the modulo. */
+    uint8_t destModulo;                               /*!< Low destination address bits allowed to change, 0 disables the modulo. */
+    bool enableHalfInterrupt;                         /*!< Interrupt when the major loop is half done. */
+    bool enableMajorInterrupt;                        /*!< Interrupt when the major loop is done. */
+    bool enableMajorLink;                             /*!< Start one minor loop of majorLinkChannel when the major loop is done. */
+    uint8_t majorLinkChannel;                         /*!< Channel linked at the end of the major loop. */
 } dma_channel_config_t;
 
+/**
+ * @brief Software transfer control descriptor.
+ *
+ * Same layout as the hardware TCD, so it can be loaded by the scatter/gather engine.
+ * Descriptors used for scatter/gather must be 32-byte aligned.
+ */
+typedef struct _dma_tcd
+{
+    uint32_t SADDR;     /*!< Source address. */
+    int16_t  SOFF;      /*!< Signed source address offset. */
+    uint16_t ATTR;      /*!< Transfer attributes. */
+    uint32_t NBYTES;    /*!< Minor loop byte count. */
+    int32_t  SLAST;     /*!< Last source address adjustment. */
+    uint32_t DADDR;     /*!< Destination address. */
+    int16_t  DOFF;      /*!< Signed destination address offset. */
+    uint16_t CITER;     /*!< Current major iteration count. */
+    int32_t  DLASTSGA;  /*!< Last destination address adjustment or next TCD address. */
+    uint16_t CSR;       /*!< Control and status. */
+    uint16_t BITER;     /*!< Beginning major iteration count. */
+} dma_tcd_t;
+
 /******************************************************************************
  * API
  ******************************************************************************/
@@ -38,6 +71,97 @@ typedef struct _dma_channel_config
 void DMA_DRV_SetChannelConfig(DMA_Type * base, uint32_t channel,
                               const dma_channel_config_t *config);
 
+/**
+ * @brief Loads a software descriptor into the hardware TCD of a channel.
+ *
+ * The channel must not be active. CSR is written last, which also clears the DONE flag.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ * @param tcd      Pointer to the descriptor to load.
+ */
+void DMA_DRV_InstallTCD(DMA_Type * base, uint32_t channel, const dma_tcd_t *tcd);
+
+/**
+ * @brief Enables the hardware request of a channel.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ */
+static inline void DMA_DRV_EnableChannelRequest(DMA_Type * base, uint8_t channel)
+{
+    base->SERQ = channel;
+}
+
+/**
+ * @brief Disables the hardware request of a channel.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ */
+static inline void DMA_DRV_DisableChannelRequest(DMA_Type * base, uint8_t channel)
+{
+    base->CERQ = channel;
+}
+
+/**
+ * @brief Clears the interrupt request flag of a channel.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ */
+static inline void DMA_DRV_ClearChannelInterrupt(DMA_Type * base, uint8_t channel)
+{
+    base->CINT = channel;
+}
+
+/**
+ * @brief Checks if the major loop of a channel is complete.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ * @return true if the DONE flag is set.
+ */
+static inline bool DMA_DRV_IsChannelDone(DMA_Type * base, uint8_t channel)
+{
+    return (0U != (base->TCD[channel].CSR & DMA_TCD_CSR_DONE_MASK));
+}
+
+/**
+ * @brief Clears the DONE flag of a channel.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ */
+static inline void DMA_DRV_ClearChannelDone(DMA_Type * base, uint8_t channel)
+{
+    base->CDNE = channel;
+}
+
+/**
+ * @brief Gets the major iterations left before the major loop is done.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ * @return Current major iteration count, reloaded from the beginning count when the loop is done.
+ */
+static inline uint16_t DMA_DRV_GetCurrentMajorCount(DMA_Type * base, uint8_t channel)
+{
+    return (uint16_t)(base->TCD[channel].CITER.ELINKNO & DMA_TCD_CITER_ELINKNO_CITER_MASK);
+}
+
+/**
+ * @brief Gets the address the channel writes next.
+ *
+ * @param base     DMA peripheral base address.
+ * @param channel  Channel index.
+ * @return Current destination address of the TCD.
+ */
+static inline uint32_t DMA_DRV_GetDestAddress(DMA_Type * base, uint8_t channel)
+{
+    return base->TCD[channel].DADDR;
+}
+
 /**
  * @brief Starts an DMA channel.
  *
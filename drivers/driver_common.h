@@ -19,6 +19,15 @@
 #ifndef   __STATIC_FORCEINLINE
   #define __STATIC_FORCEINLINE      __attribute__((always_inline)) static inline
 #endif
+
+/* Priority bits implemented by the NVIC, the upper bits of each 8-bit priority field */
+#ifndef   __NVIC_PRIO_BITS
+  #ifdef  FEATURE_NVIC_PRIO_BITS
+    #define __NVIC_PRIO_BITS        FEATURE_NVIC_PRIO_BITS
+  #else
+    #define __NVIC_PRIO_BITS        4U
+  #endif
+#endif
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -34,6 +43,48 @@ __STATIC_FORCEINLINE void __disable_irq(void)
 	__asm volatile ("cpsid i" : : : "memory");
 }
 
+/**
+ * @brief   Data Memory Barrier
+ *
+ * Ensures the apparent order of the explicit memory operations before
+ * and after the instruction, without ensuring their completion.
+ */
+__STATIC_FORCEINLINE void __DMB(void)
+{
+	__asm volatile ("dmb 0xF" : : : "memory");
+}
+
+/**
+ * @brief   Data Synchronization Barrier
+ *
+ * Completes all explicit memory accesses before the next instruction executes.
+ */
+__STATIC_FORCEINLINE void __DSB(void)
+{
+	__asm volatile ("dsb 0xF" : : : "memory");
+}
+
+/**
+ * @brief   Instruction Synchronization Barrier
+ *
+ * Flushes the pipeline, so that following instructions see the effect of earlier ones.
+ */
+__STATIC_FORCEINLINE void __ISB(void)
+{
+	__asm volatile ("isb 0xF" : : : "memory");
+}
+
+/**
+ * @brief   Wait For Interrupt
+ *
+ * Suspends execution until an interrupt becomes pending. A pending interrupt wakes
+ * the core even while PRIMASK masks it, it is then taken once PRIMASK is cleared.
+ */
+__STATIC_FORCEINLINE void __WFI(void)
+{
+	__asm volatile ("wfi" : : : "memory");
+}
+
 /**
  * @brief   Get Priority Mask
  *
@@ -59,6 +110,42 @@ __STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
 	__asm volatile ("MSR primask, %0" : : "r" (priMask) : "memory");
 }
 
+/**
+ * @brief   Get Base Priority
+ *
+ * Returns the current value of the Base Priority register.
+ *
+ * @return               Base Priority register value
+ */
+__STATIC_FORCEINLINE uint32_t __get_BASEPRI(void)
+{
+  uint32_t result;
+
+  __asm volatile ("MRS %0, basepri" : "=r" (result) );
+  return(result);
+}
+
+/**
+ * @brief   Set Base Priority
+ * Assigns the given value to the Base Priority register, 0 masks nothing.
+ * @param [in]    basePri  Base Priority value to set
+ */
+__STATIC_FORCEINLINE void __set_BASEPRI(uint32_t basePri)
+{
+	__asm volatile ("MSR basepri, %0" : : "r" (basePri) : "memory");
+}
+
+/**
+ * @brief   Set Base Priority with condition
+ * Assigns the given value to the Base Priority register only if it masks more than
+ * the current value, so nested critical sections never lower the mask.
+ * @param [in]    basePri  Base Priority value to set
+ */
+__STATIC_FORCEINLINE void __set_BASEPRI_MAX(uint32_t basePri)
+{
+	__asm volatile ("MSR basepri_max, %0" : : "r" (basePri) : "memory");
+}
+
 /**
  * @brief Disable the global IRQ
  *
@@ -91,6 +178,38 @@ static inline void EnableGlobalIRQ(uint32_t primask)
     __set_PRIMASK(primask);
 }
 
+/**
+ * @brief Disable the IRQs from a priority level down
+ *
+ * Masks every interrupt whose priority value is priority or higher, i.e. of the same or lower
+ * urgency, through BASEPRI. More urgent interrupts keep preempting the critical section. The
+ * mask is only ever raised, so the calls nest. User is required to pass the returned value to
+ * EnableIRQByPriority().
+ *
+ * @param priority NVIC priority from 1 to (1 << __NVIC_PRIO_BITS) - 1, 0 cannot be masked this way.
+ * @return Current BASEPRI value.
+ */
+static inline uint32_t DisableIRQByPriority(uint32_t priority)
+{
+    uint32_t basepri = __get_BASEPRI();
+
+    assert((priority != 0U) && (priority < (1UL << __NVIC_PRIO_BITS)));
+    __set_BASEPRI_MAX(priority << (8U - __NVIC_PRIO_BITS));
+    __ISB();
+
+    return basepri;
+}
+
+/**
+ * @brief Enable the IRQs masked by DisableIRQByPriority()
+ *
+ * @param basepri value of BASEPRI returned by the matching DisableIRQByPriority().
+ */
+static inline void EnableIRQByPriority(uint32_t basepri)
+{
+    __set_BASEPRI(basepri);
+}
+
 #endif /* DRIVERS_DRIVER_COMMON_H_ */
 
 /******************************************************************************
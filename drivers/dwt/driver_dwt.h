@@ -0,0 +1,59 @@
+#ifndef DRIVERS_DRIVER_DWT_H_
+#define DRIVERS_DRIVER_DWT_H_
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "driver_common.h"
+
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Cortex-M4 debug registers, the device header does not describe them */
+#define DWT_CTRL                    (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CYCCNT                  (*(volatile uint32_t *)0xE0001004UL)
+#define CORE_DEBUG_DEMCR            (*(volatile uint32_t *)0xE000EDFCUL)
+
+#define DWT_CTRL_CYCCNTENA_MASK     0x1UL
+#define DWT_CTRL_NOCYCCNT_MASK      0x2000000UL
+#define CORE_DEBUG_DEMCR_TRCENA_MASK 0x1000000UL
+
+/******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Enables the trace block and starts the cycle counter from zero.
+ *
+ * @retval true   The cycle counter is running.
+ * @retval false  The core does not implement a cycle counter.
+ */
+static inline bool DWT_DRV_Init(void)
+{
+    CORE_DEBUG_DEMCR |= CORE_DEBUG_DEMCR_TRCENA_MASK;
+    if (0U != (DWT_CTRL & DWT_CTRL_NOCYCCNT_MASK))
+    {
+        return false;
+    }
+    DWT_CYCCNT = 0U;
+    DWT_CTRL  |= DWT_CTRL_CYCCNTENA_MASK;
+
+    return true;
+}
+
+/**
+ * @brief Reads the core cycle counter.
+ *
+ * The counter wraps every 2^32 cycles, differences of two reads are valid across one wrap.
+ *
+ * @return Current cycle count.
+ */
+static inline uint32_t DWT_DRV_GetCycles(void)
+{
+    return DWT_CYCCNT;
+}
+
+#endif /* DRIVERS_DRIVER_DWT_H_ */
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
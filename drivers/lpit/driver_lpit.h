@@ -111,7 +111,7 @@ static inline void LPIT_DRV_EnableInterrupts(LPIT_Type *base, uint32_t mask)
  */
 static inline void LPIT_DRV_DisableInterrupts(LPIT_Type *base, uint32_t mask)
 {
-    base->MIER = ~mask;
+    base->MIER &= ~mask;
 }
 
 /**
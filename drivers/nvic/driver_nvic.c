@@ -3,6 +3,15 @@
  ******************************************************************************/
 #include "driver_nvic.h"
 
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define NVIC_IRQ_WORD(IRQn)     ((uint32_t)(IRQn) >> 5U)
+#define NVIC_IRQ_BIT(IRQn)      (1UL << ((uint32_t)(IRQn) & 0x1FU))
+
+/* Byte of SHPR1..SHPR3 holding the priority of system exception IRQn, from MemManage (4) on */
+#define SCB_SHP(IRQn)           (((volatile uint8_t *)&S32_SCB->SHPR1)[((uint32_t)(IRQn) & 0xFU) - 4U])
+
 /******************************************************************************
  * Code
  ******************************************************************************/
@@ -10,13 +19,96 @@ void NVIC_EnableIRQ(IRQn_Type IRQn)
 {
     if ((int32_t)(IRQn) >= 0)
     {
-        S32_NVIC->ISER[(uint32_t)(IRQn) >> 5U] |=
-                       (uint32_t)(1UL << ((uint32_t)(IRQn) & (uint32_t)0x1FU));
+        /* Writing 0 has no effect, so no read-modify-write is needed */
+        S32_NVIC->ISER[NVIC_IRQ_WORD(IRQn)] = NVIC_IRQ_BIT(IRQn);
+    }
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)(IRQn) >= 0)
+    {
+        S32_NVIC->ICER[NVIC_IRQ_WORD(IRQn)] = NVIC_IRQ_BIT(IRQn);
+        /* Make sure the interrupt cannot fire after return */
+        __DSB();
+        __ISB();
+    }
+}
+
+bool NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+    return ((int32_t)(IRQn) >= 0) &&
+           (0U != (S32_NVIC->ISER[NVIC_IRQ_WORD(IRQn)] & NVIC_IRQ_BIT(IRQn)));
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)(IRQn) >= 0)
+    {
+        S32_NVIC->ISPR[NVIC_IRQ_WORD(IRQn)] = NVIC_IRQ_BIT(IRQn);
+    }
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)(IRQn) >= 0)
+    {
+        S32_NVIC->ICPR[NVIC_IRQ_WORD(IRQn)] = NVIC_IRQ_BIT(IRQn);
+    }
+}
+
+bool NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+    return ((int32_t)(IRQn) >= 0) &&
+           (0U != (S32_NVIC->ISPR[NVIC_IRQ_WORD(IRQn)] & NVIC_IRQ_BIT(IRQn)));
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    /* Implemented bits are the most significant ones of each priority byte */
+    uint8_t value = (uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFU);
+
+    if ((int32_t)(IRQn) >= 0)
+    {
+        S32_NVIC->IP[(uint32_t)(IRQn)] = value;
+    }
+    else
+    {
+        SCB_SHP(IRQn) = value;
+    }
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type IRQn)
+{
+    uint8_t value;
+
+    if ((int32_t)(IRQn) >= 0)
+    {
+        value = S32_NVIC->IP[(uint32_t)(IRQn)];
+    }
+    else
+    {
+        value = SCB_SHP(IRQn);
     }
+
+    return (uint32_t)value >> (8U - __NVIC_PRIO_BITS);
+}
+
+void NVIC_SetPriorityGrouping(uint32_t group)
+{
+    uint32_t reg = S32_SCB->AIRCR;
+
+    /* VECTKEY reads back as its complement, it must be written on every access */
+    reg &= ~(S32_SCB_AIRCR_VECTKEY_MASK | S32_SCB_AIRCR_PRIGROUP_MASK);
+    reg |= S32_SCB_AIRCR_VECTKEY(NVIC_AIRCR_VECTKEY) | S32_SCB_AIRCR_PRIGROUP(group);
+    S32_SCB->AIRCR = reg;
+}
+
+uint32_t NVIC_GetPriorityGrouping(void)
+{
+    return (S32_SCB->AIRCR & S32_SCB_AIRCR_PRIGROUP_MASK) >> S32_SCB_AIRCR_PRIGROUP_SHIFT;
 }
 
 /******************************************************************************
  * EOF
  ******************************************************************************/
-
-
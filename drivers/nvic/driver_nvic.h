@@ -9,6 +9,8 @@
 /******************************************************************************
  * Definitions
  ******************************************************************************/
+/* Key required by every write to SCB AIRCR */
+#define NVIC_AIRCR_VECTKEY      0x05FAU
 
 /******************************************************************************
  * API
@@ -20,6 +22,83 @@
  */
 void NVIC_EnableIRQ(IRQn_Type IRQn);
 
+/**
+ * @brief Disable a device specific interrupt.
+ *
+ * The interrupt cannot be taken any more once the function returns.
+ *
+ * @param IRQn  Interrupt number
+ */
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Get the enable state of a device specific interrupt.
+ *
+ * @param IRQn  Interrupt number
+ * @retval true   The interrupt is enabled.
+ * @retval false  The interrupt is disabled or IRQn is a system exception.
+ */
+bool NVIC_GetEnableIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Set a device specific interrupt pending.
+ *
+ * @param IRQn  Interrupt number
+ */
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Clear the pending state of a device specific interrupt.
+ *
+ * @param IRQn  Interrupt number
+ */
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Get the pending state of a device specific interrupt.
+ *
+ * @param IRQn  Interrupt number
+ * @retval true   The interrupt is pending.
+ * @retval false  The interrupt is not pending or IRQn is a system exception.
+ */
+bool NVIC_GetPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Set the priority of an interrupt or of a configurable system exception.
+ *
+ * Lower values have higher priority. Only the __NVIC_PRIO_BITS implemented bits are kept.
+ *
+ * @param IRQn      Interrupt number, negative for system exceptions such as SysTick_IRQn
+ * @param priority  Priority from 0 to (1 << __NVIC_PRIO_BITS) - 1
+ */
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+
+/**
+ * @brief Get the priority of an interrupt or of a configurable system exception.
+ *
+ * @param IRQn  Interrupt number, negative for system exceptions such as SysTick_IRQn
+ * @return Priority from 0 to (1 << __NVIC_PRIO_BITS) - 1
+ */
+uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+
+/**
+ * @brief Set the priority grouping.
+ *
+ * Splits the priority bits into a preemption group and a subpriority. Bits of the
+ * value below 8 - __NVIC_PRIO_BITS select no implemented bit, so values 0 to 3 all
+ * mean 16 preemption levels on this device.
+ *
+ * @param group  AIRCR PRIGROUP value, from 0 to 7
+ */
+void NVIC_SetPriorityGrouping(uint32_t group);
+
+/**
+ * @brief Get the priority grouping.
+ *
+ * @return AIRCR PRIGROUP value, from 0 to 7
+ */
+uint32_t NVIC_GetPriorityGrouping(void);
+
 #endif /* DRIVERS_DRIVER_NVIC_H_ */
 
 /******************************************************************************
@@ -36,6 +36,20 @@ typedef enum _port_mux
     PORT_MuxAlt7             = 7U,
 } port_mux_t;
 
+/* @brief Digital filter clock source */
+typedef enum _port_filter_clock
+{
+    PORT_FilterClockBus      = 0U,  /* Bus clock. */
+    PORT_FilterClockLpo      = 1U,  /* 128 kHz LPO, keeps running in low power modes. */
+} port_filter_clock_t;
+
+/* @brief Digital filter configuration, shared by every pin of a port */
+typedef struct _port_digital_filter_config
+{
+    port_filter_clock_t clockSource;    /* Clock the filter samples on. */
+    uint8_t             width;          /* Glitches shorter than width clock cycles are rejected, 0 to 31. */
+} port_digital_filter_config_t;
+
 /******************************************************************************
  * API
  ******************************************************************************/
@@ -115,6 +129,48 @@ static inline void PORT_DRV_ClearPinsInterruptFlags(PORT_Type *base,
     base->ISFR = mask;
 }
 
+/**
+ * @brief Configures the digital filter clock and width of a port.
+ *
+ * The hardware has a single width per port. The pins filtering is suspended while
+ * the configuration changes, as the filter must not be reconfigured while in use.
+ *
+ * @param base    PORT peripheral base pointer.
+ * @param config  Digital filter clock source and width.
+ */
+static inline void PORT_DRV_SetDigitalFilterConfig(PORT_Type *base,
+                                                   const port_digital_filter_config_t *config)
+{
+    uint32_t enabled = base->DFER;
+
+    base->DFER = 0U;
+    base->DFCR = PORT_DFCR_CS(config->clockSource);
+    base->DFWR = PORT_DFWR_FILT(config->width);
+    base->DFER = enabled;
+}
+
+/**
+ * @brief Enables or disables the digital filter of multiple pins.
+ *
+ * A filtered pin only changes state, and raises its interrupt, once its input has been
+ * stable for the port filter width.
+ *
+ * @param base    PORT peripheral base pointer.
+ * @param mask    PORT pins mask, bit n selects pin n.
+ * @param enable  true to filter the pins, false to bypass the filter.
+ */
+static inline void PORT_DRV_EnablePinsDigitalFilter(PORT_Type *base, uint32_t mask, bool enable)
+{
+    if (enable)
+    {
+        base->DFER |= mask;
+    }
+    else
+    {
+        base->DFER &= ~mask;
+    }
+}
+
 #endif /* DRIVERS_DRIVER_PORT_H_ */
 
 /******************************************************************************
@@ -41,8 +41,9 @@ typedef struct _sim_adc0_opt
  */
 static inline void SIM_DRV_ADC0option(sim_adc0_opt_t *option)
 {
-    SIM->ADCOPT |= SIM_ADCOPT_ADC0TRGSEL(option->ADC_Trigger_source) |
-                   SIM_ADCOPT_ADC0PRETRGSEL(option->ADC_PreTrigger_source);
+    SIM->ADCOPT = (SIM->ADCOPT & ~(SIM_ADCOPT_ADC0TRGSEL_MASK | SIM_ADCOPT_ADC0PRETRGSEL_MASK)) |
+                  SIM_ADCOPT_ADC0TRGSEL(option->ADC_Trigger_source) |
+                  SIM_ADCOPT_ADC0PRETRGSEL(option->ADC_PreTrigger_source);
 }
 
 #endif /* DRIVERS_SIM_DRIVER_SIM_H_ */
@@ -3,6 +3,19 @@
  ******************************************************************************/
 #include "driver_systick.h"
 
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define NS_PER_SECOND   1000000000ULL
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* Written only by SysTick_Handler, readers retry if it changes under them */
+static volatile uint64_t s_systickTicks = 0U;
+/* Core clock cycles per SysTick period */
+static uint32_t s_systickPeriod = 0U;
+
 /******************************************************************************
  * Code
  ******************************************************************************/
@@ -16,6 +29,8 @@ uint32_t SysTick_Config	(uint32_t ticks)
     }
     else
     {
+        s_systickTicks  = 0U;
+        s_systickPeriod = ticks;
         /* Set reload register */
         S32_SysTick->RVR  = (uint32_t)(ticks - 1UL);
         /* Load the SysTick Counter Value */
@@ -29,6 +44,65 @@ uint32_t SysTick_Config	(uint32_t ticks)
     return retVal;
 }
 
+void SysTick_DRV_IncTick(void)
+{
+    s_systickTicks++;
+}
+
+void SysTick_DRV_AddTicks(uint32_t ticks)
+{
+    s_systickTicks += ticks;
+}
+
+uint64_t SysTick_DRV_GetTicks(void)
+{
+    uint64_t ticks;
+
+    /* A 64-bit read is two loads, repeat it if the interrupt ran in between */
+    do
+    {
+        ticks = s_systickTicks;
+    } while (ticks != s_systickTicks);
+
+    return ticks;
+}
+
+uint64_t SysTick_DRV_GetCycles(void)
+{
+    uint64_t ticks;
+    uint32_t value;
+    uint32_t wrapped;
+
+    /* Repeat if the handler ran during the read */
+    do
+    {
+        ticks   = s_systickTicks;
+        value   = S32_SysTick->CVR;
+        wrapped = 0U;
+        if (0U != (S32_SCB->ICSR & S32_SCB_ICSR_PENDSTSET_MASK))
+        {
+            /*
+             * The counter wrapped but the handler has not counted it yet, because the caller
+             * masks it. The value read again after the pending bit belongs to the new period.
+             */
+            value   = S32_SysTick->CVR;
+            wrapped = 1U;
+        }
+    } while (ticks != s_systickTicks);
+
+    /* The counter runs down from RVR, so the cycles elapsed in the period are RVR - CVR */
+    return ((ticks + wrapped) * s_systickPeriod) + (uint64_t)((s_systickPeriod - 1U) - value);
+}
+
+uint64_t SysTick_DRV_CyclesToNs(uint64_t cycles)
+{
+    uint64_t seconds = cycles / SystemCoreClock;
+    uint64_t rest    = cycles % SystemCoreClock;
+
+    /* Split at whole seconds so that cycles * 1e9 never overflows */
+    return (seconds * NS_PER_SECOND) + ((rest * NS_PER_SECOND) / SystemCoreClock);
+}
+
 /******************************************************************************
  * EOF
  ******************************************************************************/
@@ -5,6 +5,7 @@
  * Includes
  ******************************************************************************/
 #include "S32K144.h"
+#include "driver_common.h"
 
 /******************************************************************************
  * API
@@ -12,12 +13,70 @@
 /**
  * @brief Initialises and starts the System Tick Timer and its interrupt.
  *
+ * The monotonic time base restarts from zero.
+ *
  * @param ticks  Number of ticks between two interrupts
  * @retval 0 - success
  *         1 - failure
  */
 uint32_t SysTick_Config	(uint32_t ticks);
 
+/**
+ * @brief Counts one SysTick period, must be called from SysTick_Handler.
+ *
+ * SysTick_Handler must run above every caller of SysTick_DRV_GetCycles() and call this
+ * before anything else, longer tick work belongs in a lower priority handler.
+ */
+void SysTick_DRV_IncTick(void);
+
+/**
+ * @brief Counts SysTick periods that elapsed with the interrupt disabled.
+ *
+ * Used by tickless idle, call with interrupts masked.
+ *
+ * @param ticks  Number of periods to add.
+ */
+void SysTick_DRV_AddTicks(uint32_t ticks);
+
+/**
+ * @brief Gets the number of SysTick interrupts counted since SysTick_Config().
+ *
+ * @return 64-bit tick count, it does not wrap in practice.
+ */
+uint64_t SysTick_DRV_GetTicks(void);
+
+/**
+ * @brief Gets the core clock cycles elapsed since SysTick_Config().
+ *
+ * Combines the tick count with the current value register. The read is lock-free and
+ * consistent from thread and interrupt context, including while SysTick_Handler is
+ * pending or interrupts are masked. Once the handler is entered the pending bit is
+ * clear, so a caller that preempted it before SysTick_DRV_IncTick() would read the old
+ * count with the reloaded counter and go back one period. The handler must therefore
+ * not be preemptible by any caller, see SysTick_DRV_IncTick().
+ *
+ * @return 64-bit monotonic cycle count.
+ */
+uint64_t SysTick_DRV_GetCycles(void);
+
+/**
+ * @brief Converts core clock cycles to nanoseconds at SystemCoreClock.
+ *
+ * @param cycles  Cycle count or difference of two cycle counts.
+ * @return Nanoseconds, without overflow for any 64-bit cycle count below 584 years.
+ */
+uint64_t SysTick_DRV_CyclesToNs(uint64_t cycles);
+
+/**
+ * @brief Gets the nanoseconds elapsed since SysTick_Config().
+ *
+ * @return 64-bit monotonic timestamp, resolution of one core clock cycle.
+ */
+static inline uint64_t SysTick_DRV_GetNs(void)
+{
+    return SysTick_DRV_CyclesToNs(SysTick_DRV_GetCycles());
+}
+
 #endif /* DRIVERS_DRIVER_SYSTICK_H_ */
 
 /******************************************************************************
@@ -22,6 +22,7 @@ typedef enum _trgmux_trigger_input
 /* @brief Defines the MUX select for peripheral trigger input. */
 typedef enum _trgmux_trigger_source
 {
+    TRGMUX_Source_Disabled  = 0x00U,
     TRGMUX_Source_LPIT_CH0  = 0x11U,
     TRGMUX_Source_LPIT_CH1  = 0x12U,
     TRGMUX_Source_LPIT_CH2  = 0x13U,
@@ -52,24 +53,29 @@ static inline void TRGMUX_DRV_SetTriggerSource(TRGMUX_Type *base,
                                             trgmux_trigger_input_t input,
                                             trgmux_trigger_source_t trigger_src)
 {
+    uint32_t reg = base->TRGMUXn[index];
+
+    /* Replace the selection, OR-ing it in would merge with the previous source */
     switch (input)
     {
         case TRGMUX_TriggerInput0:
-            base->TRGMUXn[index] |= TRGMUX_TRGMUXn_SEL0(trigger_src);
+            reg = (reg & ~TRGMUX_TRGMUXn_SEL0_MASK) | TRGMUX_TRGMUXn_SEL0(trigger_src);
             break;
         case TRGMUX_TriggerInput1:
-            base->TRGMUXn[index] |= TRGMUX_TRGMUXn_SEL1(trigger_src);
+            reg = (reg & ~TRGMUX_TRGMUXn_SEL1_MASK) | TRGMUX_TRGMUXn_SEL1(trigger_src);
             break;
         case TRGMUX_TriggerInput2:
-            base->TRGMUXn[index] |= TRGMUX_TRGMUXn_SEL2(trigger_src);
+            reg = (reg & ~TRGMUX_TRGMUXn_SEL2_MASK) | TRGMUX_TRGMUXn_SEL2(trigger_src);
             break;
         case TRGMUX_TriggerInput3:
-            base->TRGMUXn[index] |= TRGMUX_TRGMUXn_SEL3(trigger_src);
+            reg = (reg & ~TRGMUX_TRGMUXn_SEL3_MASK) | TRGMUX_TRGMUXn_SEL3(trigger_src);
             break;
         default:
             /* Nothing */
             break;
     }
+
+    base->TRGMUXn[index] = reg;
 }
 
 #endif /* DRIVERS_TRGMUX_DRIVER_TRGMUX_H_ */
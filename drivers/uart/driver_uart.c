@@ -2,20 +2,139 @@
  * Includes
  ******************************************************************************/
 #include "driver_uart.h"
+#include "driver_dma.h"
+#include "ring_buffer.h"
 
 /******************************************************************************
  * Definitions
  ******************************************************************************/
+#if ((LPUART_TX_RING_SIZE & (LPUART_TX_RING_SIZE - 1U)) != 0U)
+#error "LPUART_TX_RING_SIZE must be a power of two"
+#endif
 
+#if ((LPUART_DMA_TX_TCD_COUNT & (LPUART_DMA_TX_TCD_COUNT - 1U)) != 0U)
+#error "LPUART_DMA_TX_TCD_COUNT must be a power of two"
+#endif
+
+
+/* @brief Status flags cleared by writing one */
+#define LPUART_STAT_W1C_FLAGS   (LPUART_STAT_LBKDIF_MASK | LPUART_STAT_RXEDGIF_MASK | \
+                                 LPUART_STAT_IDLE_MASK   | LPUART_STAT_OR_MASK      | \
+                                 LPUART_STAT_NF_MASK     | LPUART_STAT_FE_MASK      | \
+                                 LPUART_STAT_PF_MASK     | LPUART_STAT_MA1F_MASK    | \
+                                 LPUART_STAT_MA2F_MASK)
+#define LPUART_DMA_TX_TCD_MASK  (LPUART_DMA_TX_TCD_COUNT - 1U)
+
+/* @brief eDMA transmit state, descriptor i always points at slot i. */
+typedef struct _lpuart_dma_tx
+{
+    dma_tcd_t tcd[LPUART_DMA_TX_TCD_COUNT] __attribute__((aligned(32)));
+    uint8_t slot[LPUART_DMA_TX_TCD_COUNT][LPUART_DMA_TX_SLOT_SIZE];
+    DMA_Type *dmaBase;
+    uint8_t channel;
+    bool enabled;
+    volatile uint32_t head;     /* Next free descriptor, written by the producer only */
+    volatile uint32_t tail;     /* Oldest queued descriptor, written by the DMA interrupt only */
+} lpuart_dma_tx_t;
+
+/* @brief Circular eDMA receive state. */
+typedef struct _lpuart_dma_rx
+{
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t readIndex;         /* First byte not yet handed to the callback */
+    DMA_Type *dmaBase;
+    uint8_t channel;
+    lpuart_rx_callback_t callback;
+} lpuart_dma_rx_t;
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+static LPUART_Type *const s_lpuartBases[] = LPUART_BASE_PTRS;
+
+static uint8_t s_lpuartTxStorage[LPUART_INSTANCE_COUNT][LPUART_TX_RING_SIZE];
+
+/* Produced by the writer, consumed by the TX interrupt */
+static ring_buffer_t s_lpuartTxRing[LPUART_INSTANCE_COUNT];
+
+static uint32_t s_lpuartTxHighWaterMark[LPUART_INSTANCE_COUNT];
+
+static lpuart_dma_tx_t s_lpuartDmaTx[LPUART_INSTANCE_COUNT];
+
+static lpuart_dma_rx_t s_lpuartDmaRx[LPUART_INSTANCE_COUNT];
 
 /******************************************************************************
  * Code
  ******************************************************************************/
+static uint32_t LPUART_DRV_GetInstance(LPUART_Type *base)
+{
+    uint32_t instance;
+
+    for (instance = 0U; instance < LPUART_INSTANCE_COUNT; instance++)
+    {
+        if (s_lpuartBases[instance] == base)
+        {
+            break;
+        }
+    }
+    assert(instance < LPUART_INSTANCE_COUNT);
+
+    return instance;
+}
+
+static uint32_t LPUART_DRV_GetTxFifoSpace(LPUART_Type *base)
+{
+    uint32_t count = (base->WATER & LPUART_WATER_TXCOUNT_MASK) >> LPUART_WATER_TXCOUNT_SHIFT;
+
+    if (0U == (base->FIFO & LPUART_FIFO_TXFE_MASK))
+    {
+        return (0U != (base->STAT & LPUART_STAT_TDRE_MASK)) ? 1U : 0U;
+    }
+
+    return LPUART_DRV_GetTxFifoSize(base) - count;
+}
+
+static uint32_t LPUART_DRV_GetRxFifoCount(LPUART_Type *base)
+{
+    if (0U == (base->FIFO & LPUART_FIFO_RXFE_MASK))
+    {
+        return (0U != (base->STAT & LPUART_STAT_RDRF_MASK)) ? 1U : 0U;
+    }
+
+    return (base->WATER & LPUART_WATER_RXCOUNT_MASK) >> LPUART_WATER_RXCOUNT_SHIFT;
+}
+
+static void LPUART_DRV_ClearStatusFlags(LPUART_Type *base, uint32_t mask)
+{
+    /* Keep the other write-one-to-clear flags untouched */
+    base->STAT = (base->STAT & ~LPUART_STAT_W1C_FLAGS) | mask;
+}
+
+static void LPUART_DRV_RxDMAService(lpuart_dma_rx_t *dmaRx)
+{
+    /* CITER counts down to 1 and is reloaded from BITER, so the index is always below size */
+    uint32_t writeIndex = dmaRx->size - dmaRx->dmaBase->TCD[dmaRx->channel].CITER.ELINKNO;
+    uint32_t readIndex  = dmaRx->readIndex;
+
+    if (writeIndex < readIndex)
+    {
+        dmaRx->callback(&dmaRx->buffer[readIndex], dmaRx->size - readIndex);
+        readIndex = 0U;
+    }
+    if (writeIndex > readIndex)
+    {
+        dmaRx->callback(&dmaRx->buffer[readIndex], writeIndex - readIndex);
+    }
+    dmaRx->readIndex = writeIndex;
+}
+
 void LPUART_DRV_Init(LPUART_Type *base, const lpuart_config_t *config, uint32_t srcClock_Hz)
 {
     assert(NULL != config);
     assert(0U < config->baudRate_Bps);
 
+    uint32_t instance = LPUART_DRV_GetInstance(base);
     uint32_t temp;
     uint16_t sbr, sbrTemp;
     uint8_t  osr, osrTemp;
@@ -113,6 +232,33 @@ void LPUART_DRV_Init(LPUART_Type *base, const lpuart_config_t *config, uint32_t
 
     base->STAT |= temp;
 
+    /* FIFOs can only be changed while the transmitter and receiver are disabled */
+    base->CTRL &= ~(LPUART_CTRL_TE_MASK | LPUART_CTRL_RE_MASK);
+
+    assert(config->txFifoWatermark < LPUART_DRV_GetTxFifoSize(base));
+    assert(config->rxFifoWatermark < LPUART_DRV_GetRxFifoSize(base));
+    assert(LPUART_DRV_GetRxFifoSize(base) <= LPUART_FIFO_SIZE_MAX);
+
+    temp = base->FIFO & ~(LPUART_FIFO_TXFE_MASK   | LPUART_FIFO_RXFE_MASK |
+                          LPUART_FIFO_RXIDEN_MASK | LPUART_FIFO_RXUF_MASK |
+                          LPUART_FIFO_TXOF_MASK);
+    if (true == config->enableTxFifo)
+    {
+        temp |= LPUART_FIFO_TXFE_MASK;
+    }
+
+    if (true == config->enableRxFifo)
+    {
+        temp |= LPUART_FIFO_RXFE_MASK;
+    }
+
+    /* Flush both FIFOs while (re)configuring them */
+    base->FIFO = temp | LPUART_FIFO_RXIDEN(config->rxIdleTimeout) |
+                 LPUART_FIFO_TXFLUSH_MASK | LPUART_FIFO_RXFLUSH_MASK;
+
+    base->WATER = LPUART_WATER_TXWATER(config->txFifoWatermark) |
+                  LPUART_WATER_RXWATER(config->rxFifoWatermark);
+
     /* Enable TX/RX base on configure structure. */
     temp = base->CTRL;
     if (true == config->enableTx)
@@ -126,6 +272,11 @@ void LPUART_DRV_Init(LPUART_Type *base, const lpuart_config_t *config, uint32_t
     }
 
     base->CTRL = temp;
+
+    /* Start with an empty transmit ring */
+    ring_buffer_init(&s_lpuartTxRing[instance], s_lpuartTxStorage[instance],
+                     1U, LPUART_TX_RING_SIZE);
+    s_lpuartTxHighWaterMark[instance] = 0U;
 }
 
 void LPUART_DRV_Deinit(LPUART_Type *base)
@@ -148,12 +299,66 @@ void LPUART_DRV_Deinit(LPUART_Type *base)
     base->CTRL = 0U;
 }
 
+size_t LPUART_DRV_WriteFifo(LPUART_Type *base, const uint8_t *data, size_t length)
+{
+    assert(NULL != data);
+
+    uint32_t space = LPUART_DRV_GetTxFifoSpace(base);
+    size_t written = 0U;
+
+    while ((written < length) && (0U != space))
+    {
+        base->DATA = data[written];
+        written++;
+        space--;
+    }
+
+    return written;
+}
+
+size_t LPUART_DRV_ReadFifo(LPUART_Type *base, uint8_t *data, size_t maxLength)
+{
+    assert(NULL != data);
+
+    uint32_t count = LPUART_DRV_GetRxFifoCount(base);
+    size_t read    = 0U;
+
+    while ((read < maxLength) && (0U != count))
+    {
+        data[read] = (uint8_t)base->DATA;
+        read++;
+        count--;
+    }
+
+    return read;
+}
+
 void LPUART_DRV_WriteBlocking(LPUART_Type *base, const uint8_t *data, size_t length)
 {
     assert(NULL != data);
 
     const uint8_t *dataAddress = data;
     size_t transferSize        = length;
+    lpuart_dma_tx_t *dmaTx     = &s_lpuartDmaTx[LPUART_DRV_GetInstance(base)];
+    size_t chunkSize;
+
+    if (dmaTx->enabled)
+    {
+        while (0U != transferSize)
+        {
+            chunkSize = (transferSize < LPUART_DMA_TX_SLOT_SIZE) ?
+                        transferSize : LPUART_DMA_TX_SLOT_SIZE;
+            /* Wait for the DMA interrupt to free a descriptor */
+            while (!LPUART_DRV_WriteDMA(base, dataAddress, chunkSize))
+            {
+            }
+            dataAddress  += chunkSize;
+            transferSize -= chunkSize;
+        }
+        while (dmaTx->tail != dmaTx->head)
+        {
+        }
+    }
 
     while (0U != transferSize)
     {
@@ -170,6 +375,285 @@ void LPUART_DRV_WriteBlocking(LPUART_Type *base, const uint8_t *data, size_t len
     }
 }
 
+bool LPUART_DRV_WriteNonBlocking(LPUART_Type *base, const uint8_t *data, size_t length)
+{
+    assert(NULL != data);
+
+    uint32_t instance   = LPUART_DRV_GetInstance(base);
+    ring_buffer_t *ring = &s_lpuartTxRing[instance];
+    uint32_t used;
+    uint32_t primask;
+
+    if (s_lpuartDmaTx[instance].enabled)
+    {
+        return LPUART_DRV_WriteDMA(base, data, length);
+    }
+
+    /* Queue all or nothing, the interrupt only ever frees space */
+    if (length > ring_buffer_free(ring))
+    {
+        return false;
+    }
+    (void)ring_buffer_push_batch(ring, data, (uint32_t)length);
+
+    used = ring_buffer_count(ring);
+    if (used > s_lpuartTxHighWaterMark[instance])
+    {
+        s_lpuartTxHighWaterMark[instance] = used;
+    }
+
+    /* CTRL is also modified by the interrupt handler */
+    primask = DisableGlobalIRQ();
+    base->CTRL |= LPUART_CTRL_TIE_MASK;
+    EnableGlobalIRQ(primask);
+
+    return true;
+}
+
+void LPUART_DRV_TxIRQHandler(LPUART_Type *base)
+{
+    ring_buffer_t *ring;
+    uint8_t chunk[8];
+    uint32_t space;
+    uint32_t count;
+
+    if ((0U == (base->CTRL & LPUART_CTRL_TIE_MASK)) ||
+        (0U == (base->STAT & LPUART_STAT_TDRE_MASK)))
+    {
+        return;
+    }
+
+    ring  = &s_lpuartTxRing[LPUART_DRV_GetInstance(base)];
+    space = LPUART_DRV_GetTxFifoSpace(base);
+
+    /* Top up the whole FIFO per interrupt */
+    while (0U != space)
+    {
+        count = ring_buffer_pop_batch(ring, chunk,
+                                      (space < sizeof(chunk)) ? space : sizeof(chunk));
+        if (0U == count)
+        {
+            break;
+        }
+        (void)LPUART_DRV_WriteFifo(base, chunk, count);
+        space -= count;
+    }
+
+    if (ring_buffer_is_empty(ring))
+    {
+        base->CTRL &= ~LPUART_CTRL_TIE_MASK;
+    }
+}
+
+uint32_t LPUART_DRV_GetTxHighWaterMark(LPUART_Type *base)
+{
+    return s_lpuartTxHighWaterMark[LPUART_DRV_GetInstance(base)];
+}
+
+void LPUART_DRV_EnableTxDMA(LPUART_Type *base, DMA_Type *dmaBase, uint8_t channel)
+{
+    assert(NULL != dmaBase);
+
+    lpuart_dma_tx_t *dmaTx = &s_lpuartDmaTx[LPUART_DRV_GetInstance(base)];
+    uint32_t i;
+
+    DMA_DRV_DisableChannelRequest(dmaBase, channel);
+
+    /* Everything but the slot address and length is the same for every descriptor */
+    for (i = 0U; i < LPUART_DMA_TX_TCD_COUNT; i++)
+    {
+        dmaTx->tcd[i].SADDR    = (uint32_t)&dmaTx->slot[i][0];
+        dmaTx->tcd[i].SOFF     = 1;
+        dmaTx->tcd[i].ATTR     = (uint16_t)(DMA_TCD_ATTR_SSIZE(DMA_TRANSFER_SIZE_1B) |
+                                            DMA_TCD_ATTR_DSIZE(DMA_TRANSFER_SIZE_1B));
+        dmaTx->tcd[i].NBYTES   = 1U;
+        dmaTx->tcd[i].SLAST    = 0;
+        dmaTx->tcd[i].DADDR    = (uint32_t)&base->DATA;
+        dmaTx->tcd[i].DOFF     = 0;
+        dmaTx->tcd[i].DLASTSGA = 0;
+    }
+
+    dmaTx->dmaBase = dmaBase;
+    dmaTx->channel = channel;
+    dmaTx->head    = 0U;
+    dmaTx->tail    = 0U;
+    dmaTx->enabled = true;
+
+    base->BAUD |= LPUART_BAUD_TDMAE_MASK;
+}
+
+/* Queues one descriptor, the caller checked that it is free */
+static void LPUART_DRV_SubmitDMA(lpuart_dma_tx_t *dmaTx, const uint8_t *data, size_t length)
+{
+    DMA_Type *dmaBase      = dmaTx->dmaBase;
+    uint32_t head          = dmaTx->head;
+    uint32_t index         = head & LPUART_DMA_TX_TCD_MASK;
+    dma_tcd_t *tcd         = &dmaTx->tcd[index];
+    dma_tcd_t *prev        = &dmaTx->tcd[(head - 1U) & LPUART_DMA_TX_TCD_MASK];
+    uint16_t csr;
+    bool linked            = false;
+
+    (void)memcpy(&dmaTx->slot[index][0], data, length);
+    tcd->CITER    = (uint16_t)length;
+    tcd->BITER    = (uint16_t)length;
+    tcd->DLASTSGA = 0;
+    tcd->CSR      = (uint16_t)(DMA_TCD_CSR_INTMAJOR_MASK | DMA_TCD_CSR_DREQ_MASK);
+
+    if (head != dmaTx->tail)
+    {
+        /* Link the previous descriptor in memory, in case the engine has not loaded it yet */
+        prev->DLASTSGA = (int32_t)(uint32_t)tcd;
+        prev->CSR      = (uint16_t)((prev->CSR | DMA_TCD_CSR_ESG_MASK) & ~DMA_TCD_CSR_DREQ_MASK);
+        __DMB();
+
+        csr = dmaBase->TCD[dmaTx->channel].CSR;
+        if (0U != (csr & DMA_TCD_CSR_ESG_MASK))
+        {
+            /* The engine still runs an earlier descriptor and will load the linked one */
+            linked = true;
+        }
+        else
+        {
+            /* The engine runs the previous descriptor, link it in place. The write to ESG
+             * does not stick if the major loop completed in the meantime. */
+            dmaBase->TCD[dmaTx->channel].DLASTSGA = (uint32_t)tcd;
+            dmaBase->TCD[dmaTx->channel].CSR      = (uint16_t)((csr | DMA_TCD_CSR_ESG_MASK) &
+                                                               ~DMA_TCD_CSR_DREQ_MASK);
+            linked = (0U != (dmaBase->TCD[dmaTx->channel].CSR & DMA_TCD_CSR_ESG_MASK));
+        }
+    }
+
+    if (!linked)
+    {
+        DMA_DRV_InstallTCD(dmaBase, dmaTx->channel, tcd);
+        DMA_DRV_EnableChannelRequest(dmaBase, dmaTx->channel);
+    }
+
+    dmaTx->head = head + 1U;
+}
+
+bool LPUART_DRV_WriteDMA(LPUART_Type *base, const uint8_t *data, size_t length)
+{
+    assert(NULL != data);
+
+    lpuart_dma_tx_t *dmaTx = &s_lpuartDmaTx[LPUART_DRV_GetInstance(base)];
+    uint32_t needed        = (uint32_t)((length + LPUART_DMA_TX_SLOT_SIZE - 1U) / LPUART_DMA_TX_SLOT_SIZE);
+    size_t chunkSize;
+
+    /* Queue all or nothing, the interrupt only ever frees descriptors */
+    if ((0U == length) ||
+        (needed > (LPUART_DMA_TX_TCD_COUNT - (dmaTx->head - dmaTx->tail))))
+    {
+        return false;
+    }
+
+    while (0U != length)
+    {
+        chunkSize = (length < LPUART_DMA_TX_SLOT_SIZE) ? length : LPUART_DMA_TX_SLOT_SIZE;
+        LPUART_DRV_SubmitDMA(dmaTx, data, chunkSize);
+        data   += chunkSize;
+        length -= chunkSize;
+    }
+
+    return true;
+}
+
+void LPUART_DRV_TxDMAIRQHandler(LPUART_Type *base)
+{
+    lpuart_dma_tx_t *dmaTx = &s_lpuartDmaTx[LPUART_DRV_GetInstance(base)];
+    DMA_Type *dmaBase      = dmaTx->dmaBase;
+    uint32_t head          = dmaTx->head;
+    uint32_t srcAddr;
+    uint32_t current;
+
+    DMA_DRV_ClearChannelInterrupt(dmaBase, dmaTx->channel);
+
+    if (DMA_DRV_IsChannelDone(dmaBase, dmaTx->channel))
+    {
+        /* The last loaded descriptor finished without a link, everything queued is out */
+        dmaTx->tail = head;
+        return;
+    }
+
+    /* Every descriptor before the one the source address points into has completed */
+    srcAddr = dmaBase->TCD[dmaTx->channel].SADDR;
+    current = (srcAddr - (uint32_t)&dmaTx->slot[0][0]) / LPUART_DMA_TX_SLOT_SIZE;
+    if (current < LPUART_DMA_TX_TCD_COUNT)
+    {
+        dmaTx->tail += (current - dmaTx->tail) & LPUART_DMA_TX_TCD_MASK;
+    }
+}
+
+void LPUART_DRV_EnableRxDMA(LPUART_Type *base, DMA_Type *dmaBase, uint8_t channel,
+                            uint8_t *buffer, size_t size, lpuart_rx_callback_t callback)
+{
+    assert(NULL != dmaBase);
+    assert(NULL != buffer);
+    assert(NULL != callback);
+    assert((0U < size) && (size <= DMA_TCD_CITER_ELINKNO_CITER_MASK));
+
+    lpuart_dma_rx_t *dmaRx = &s_lpuartDmaRx[LPUART_DRV_GetInstance(base)];
+    dma_channel_config_t config =
+    {
+        .srcAddr              = (uint32_t)&base->DATA,
+        .srcTransferSize      = DMA_TRANSFER_SIZE_1B,
+        .destAddr             = (uint32_t)buffer,
+        .destTransferSize     = DMA_TRANSFER_SIZE_1B,
+        .srcOffset            = 0,
+        .destOffset           = 1,
+        .minorLoopBytes       = 1U,
+        .majorLoopCount       = (uint16_t)size,
+        .srcLastAdjust        = 0,
+        .destLastAdjust       = -(int32_t)size,
+        .enableHalfInterrupt  = true,
+        .enableMajorInterrupt = true,
+    };
+
+    dmaRx->buffer    = buffer;
+    dmaRx->size      = (uint32_t)size;
+    dmaRx->readIndex = 0U;
+    dmaRx->dmaBase   = dmaBase;
+    dmaRx->channel   = channel;
+    dmaRx->callback  = callback;
+
+    DMA_DRV_SetChannelConfig(dmaBase, channel, &config);
+
+    /* Idle is counted after the stop bit so a long frame cannot raise it early */
+    base->CTRL = (base->CTRL & ~(LPUART_CTRL_RIE_MASK | LPUART_CTRL_IDLECFG_MASK)) |
+                 LPUART_CTRL_ILT_MASK | LPUART_CTRL_IDLECFG(0U);
+    LPUART_DRV_ClearStatusFlags(base, LPUART_STAT_IDLE_MASK | LPUART_STAT_OR_MASK);
+    base->BAUD |= LPUART_BAUD_RDMAE_MASK;
+    base->CTRL |= LPUART_CTRL_ILIE_MASK;
+}
+
+void LPUART_DRV_RxIdleIRQHandler(LPUART_Type *base)
+{
+    lpuart_dma_rx_t *dmaRx;
+    uint32_t stat = base->STAT;
+
+    if (0U == (stat & (LPUART_STAT_IDLE_MASK | LPUART_STAT_OR_MASK)))
+    {
+        return;
+    }
+
+    /* An overrun stops the receiver until the flag is cleared */
+    LPUART_DRV_ClearStatusFlags(base, stat & (LPUART_STAT_IDLE_MASK | LPUART_STAT_OR_MASK));
+
+    dmaRx = &s_lpuartDmaRx[LPUART_DRV_GetInstance(base)];
+    if (NULL != dmaRx->callback)
+    {
+        LPUART_DRV_RxDMAService(dmaRx);
+    }
+}
+
+void LPUART_DRV_RxDMAIRQHandler(LPUART_Type *base)
+{
+    lpuart_dma_rx_t *dmaRx = &s_lpuartDmaRx[LPUART_DRV_GetInstance(base)];
+
+    DMA_DRV_ClearChannelInterrupt(dmaRx->dmaBase, dmaRx->channel);
+    LPUART_DRV_RxDMAService(dmaRx);
+}
+
 /******************************************************************************
  * EOF
  ******************************************************************************/
@@ -9,6 +9,25 @@
 /******************************************************************************
  * Definitions
  ******************************************************************************/
+/* @brief Size of the software transmit ring of each LPUART instance, must be a power of two. */
+#ifndef LPUART_TX_RING_SIZE
+#define LPUART_TX_RING_SIZE     64U
+#endif
+
+/* @brief Number of eDMA transmit descriptors of each LPUART instance, must be a power of two. */
+#ifndef LPUART_DMA_TX_TCD_COUNT
+#define LPUART_DMA_TX_TCD_COUNT 8U
+#endif
+
+/* @brief Largest write accepted by one eDMA transmit descriptor. */
+#ifndef LPUART_DMA_TX_SLOT_SIZE
+#define LPUART_DMA_TX_SLOT_SIZE 16U
+#endif
+
+/* @brief Deepest LPUART FIFO of the device in words, the RX FIFO depth reported by
+ *        LPUART_DRV_GetRxFifoSize() never exceeds it. */
+#define LPUART_FIFO_SIZE_MAX    4U
+
 /* @brief LPUART parity mode. */
 typedef enum _lpuart_parity_mode
 {
@@ -38,6 +57,26 @@ typedef enum _lpuart_idle_type_select
     LPUART_IdleTypeStopBit  = 1U, /* Start counting after a stop bit. */
 } lpuart_idle_type_select_t;
 
+/* @brief Number of idle characters after which the RX FIFO asserts RDRF below the watermark. */
+typedef enum _lpuart_rx_idle_timeout
+{
+    LPUART_RxIdleTimeoutDisabled = 0U, /* Idle timeout disabled. */
+    LPUART_RxIdleTimeout1Char    = 1U, /* RDRF asserts after 1 idle character. */
+    LPUART_RxIdleTimeout2Char    = 2U, /* RDRF asserts after 2 idle characters. */
+    LPUART_RxIdleTimeout4Char    = 3U, /* RDRF asserts after 4 idle characters. */
+    LPUART_RxIdleTimeout8Char    = 4U, /* RDRF asserts after 8 idle characters. */
+    LPUART_RxIdleTimeout16Char   = 5U, /* RDRF asserts after 16 idle characters. */
+    LPUART_RxIdleTimeout32Char   = 6U, /* RDRF asserts after 32 idle characters. */
+    LPUART_RxIdleTimeout64Char   = 7U, /* RDRF asserts after 64 idle characters. */
+} lpuart_rx_idle_timeout_t;
+
+/**
+ * @brief Receive callback, called with each span of bytes the eDMA receiver has stored.
+ *
+ * Runs in interrupt context.
+ */
+typedef void (*lpuart_rx_callback_t)(const uint8_t *data, size_t length);
+
 /* @brief LPUART configuration structure. */
 typedef struct _lpuart_config
 {
@@ -48,6 +87,11 @@ typedef struct _lpuart_config
     lpuart_stop_bit_count_t stopBitCount;  /* Number of stop bits, 1 stop bit (default) or 2 stop bits  */
     bool enableTx;                         /* Enable TX */
     bool enableRx;                         /* Enable RX */
+    bool enableTxFifo;                     /* Enable TX FIFO */
+    bool enableRxFifo;                     /* Enable RX FIFO */
+    uint8_t txFifoWatermark;               /* TDRE asserts when the TX FIFO holds this many words or fewer */
+    uint8_t rxFifoWatermark;               /* RDRF asserts when the RX FIFO holds more words than this */
+    lpuart_rx_idle_timeout_t rxIdleTimeout; /* Assert RDRF below the watermark after an idle line */
 } lpuart_config_t;
 
 /******************************************************************************
@@ -66,6 +110,11 @@ typedef struct _lpuart_config
  *  lpuartConfig.dataBitsCount = LPUART_EightDataBits;
  *  lpuartConfig.isMsb = false;
  *  lpuartConfig.stopBitCount = LPUART_OneStopBit;
+ *  lpuartConfig.enableTxFifo = true;
+ *  lpuartConfig.enableRxFifo = true;
+ *  lpuartConfig.txFifoWatermark = 1U;
+ *  lpuartConfig.rxFifoWatermark = 2U;
+ *  lpuartConfig.rxIdleTimeout = LPUART_RxIdleTimeout1Char;
  *  LPUART_Init(LPUART1, &lpuartConfig, 20000000U);
  * @endcode
  *
@@ -114,11 +163,74 @@ static inline uint8_t LPUART_DRV_ReadByte(LPUART_Type *base)
     return (uint8_t)(base->DATA);
 }
 
+/**
+ * @brief Decodes a FIFO size field of the FIFO register into a number of words.
+ *
+ * @param field  TXFIFOSIZE or RXFIFOSIZE field value.
+ * @return FIFO depth in words.
+ */
+static inline uint32_t LPUART_DRV_DecodeFifoSize(uint32_t field)
+{
+    return (0U == field) ? 1U : (1UL << (field + 1U));
+}
+
+/**
+ * @brief Gets the depth of the TX FIFO.
+ *
+ * @param base  LPUART peripheral base address.
+ * @return TX FIFO depth in words.
+ */
+static inline uint32_t LPUART_DRV_GetTxFifoSize(LPUART_Type *base)
+{
+    return LPUART_DRV_DecodeFifoSize((base->FIFO & LPUART_FIFO_TXFIFOSIZE_MASK) >>
+                                     LPUART_FIFO_TXFIFOSIZE_SHIFT);
+}
+
+/**
+ * @brief Gets the depth of the RX FIFO.
+ *
+ * @param base  LPUART peripheral base address.
+ * @return RX FIFO depth in words.
+ */
+static inline uint32_t LPUART_DRV_GetRxFifoSize(LPUART_Type *base)
+{
+    return LPUART_DRV_DecodeFifoSize((base->FIFO & LPUART_FIFO_RXFIFOSIZE_MASK) >>
+                                     LPUART_FIFO_RXFIFOSIZE_SHIFT);
+}
+
+/**
+ * @brief Writes as many bytes as the transmitter can take right now.
+ *
+ * This function never waits. With the TX FIFO enabled it fills every free FIFO entry,
+ * otherwise it writes at most one byte when TDRE is set.
+ *
+ * @param base    LPUART peripheral base address.
+ * @param data    Start address of the data to write.
+ * @param length  Size of the data to write.
+ * @return Number of bytes written.
+ */
+size_t LPUART_DRV_WriteFifo(LPUART_Type *base, const uint8_t *data, size_t length);
+
+/**
+ * @brief Reads every byte the receiver holds right now.
+ *
+ * This function never waits. With the RX FIFO enabled it empties the FIFO,
+ * otherwise it reads at most one byte when RDRF is set.
+ *
+ * @param base       LPUART peripheral base address.
+ * @param data       Start address of the receive buffer.
+ * @param maxLength  Size of the receive buffer.
+ * @return Number of bytes read.
+ */
+size_t LPUART_DRV_ReadFifo(LPUART_Type *base, uint8_t *data, size_t maxLength);
+
 /**
  * @brief Writes to the transmitter register using a blocking method.
  *
  * This function polls the transmitter register, first waits for the register to be empty or TX FIFO to have room,
  * and writes data to the transmitter buffer, then waits for the data to be sent out to the bus.
+ * When eDMA transmit is enabled on the instance the data is handed to the DMA channel instead and
+ * the function only waits for the channel to drain, so it must not be called with interrupts masked.
  *
  * @param base    LPUART peripheral base address.
  * @param data    Start address of the data to write.
@@ -126,6 +238,115 @@ static inline uint8_t LPUART_DRV_ReadByte(LPUART_Type *base)
  */
 void LPUART_DRV_WriteBlocking(LPUART_Type *base, const uint8_t *data, size_t length);
 
+/**
+ * @brief Queues data for interrupt-driven transmission.
+ *
+ * The data is copied into the software transmit ring of the instance and the TDRE interrupt is
+ * enabled, the function never waits for the transmitter. The data is queued as a whole or not
+ * at all, so a frame is never split when the ring is short of space.
+ * LPUART_DRV_TxIRQHandler() must be called from the instance interrupt handler.
+ * When eDMA transmit is enabled on the instance the call is forwarded to LPUART_DRV_WriteDMA().
+ *
+ * @param base    LPUART peripheral base address.
+ * @param data    Start address of the data to write.
+ * @param length  Size of the data to write.
+ * @retval true   The data was queued.
+ * @retval false  Not enough room in the transmit ring, nothing was queued.
+ */
+bool LPUART_DRV_WriteNonBlocking(LPUART_Type *base, const uint8_t *data, size_t length);
+
+/**
+ * @brief Drains the software transmit ring into the transmitter.
+ *
+ * Call this function from the LPUART interrupt handler. It does nothing unless the TDRE interrupt
+ * is enabled and pending, and disables the TDRE interrupt once the ring is empty.
+ *
+ * @param base  LPUART peripheral base address.
+ */
+void LPUART_DRV_TxIRQHandler(LPUART_Type *base);
+
+/**
+ * @brief Gets the highest fill level the software transmit ring has reached.
+ *
+ * @param base  LPUART peripheral base address.
+ * @return High-water mark of the transmit ring in bytes.
+ */
+uint32_t LPUART_DRV_GetTxHighWaterMark(LPUART_Type *base);
+
+/**
+ * @brief Switches the transmitter of an instance to eDMA mode.
+ *
+ * The caller routes the LPUART TX request to the channel through DMAMUX and enables the channel
+ * interrupt, whose handler must call LPUART_DRV_TxDMAIRQHandler().
+ *
+ * @param base     LPUART peripheral base address.
+ * @param dmaBase  DMA peripheral base address.
+ * @param channel  DMA channel serving the LPUART TX request.
+ */
+void LPUART_DRV_EnableTxDMA(LPUART_Type *base, DMA_Type *dmaBase, uint8_t channel);
+
+/**
+ * @brief Queues data for eDMA transmission.
+ *
+ * The data is copied into one descriptor slot per LPUART_DMA_TX_SLOT_SIZE bytes. A descriptor
+ * queued while the channel is busy is chained to the previous one through scatter/gather, so
+ * consecutive frames go out back-to-back without CPU involvement.
+ *
+ * @param base    LPUART peripheral base address.
+ * @param data    Start address of the data to write.
+ * @param length  Size of the data to write.
+ * @retval true   The data was queued.
+ * @retval false  Not enough free descriptors, nothing was queued.
+ */
+bool LPUART_DRV_WriteDMA(LPUART_Type *base, const uint8_t *data, size_t length);
+
+/**
+ * @brief Retires the eDMA transmit descriptors the channel has completed.
+ *
+ * Call this function from the interrupt handler of the DMA channel given to LPUART_DRV_EnableTxDMA().
+ *
+ * @param base  LPUART peripheral base address.
+ */
+void LPUART_DRV_TxDMAIRQHandler(LPUART_Type *base);
+
+/**
+ * @brief Switches the receiver of an instance to circular eDMA mode.
+ *
+ * The channel writes every received byte into the circular buffer without CPU involvement.
+ * Received spans are handed to the callback when the line goes idle and when the buffer is half
+ * and completely filled, instead of one interrupt per byte. The RDRF interrupt must be left
+ * disabled. The caller routes the LPUART RX request to the channel through DMAMUX, calls
+ * LPUART_DRV_RxIdleIRQHandler() from the LPUART interrupt and LPUART_DRV_RxDMAIRQHandler() from
+ * the channel interrupt. Both interrupts must have the same priority.
+ *
+ * @param base      LPUART peripheral base address.
+ * @param dmaBase   DMA peripheral base address.
+ * @param channel   DMA channel serving the LPUART RX request.
+ * @param buffer    Circular receive buffer.
+ * @param size      Size of the receive buffer in bytes.
+ * @param callback  Function receiving the stored spans.
+ */
+void LPUART_DRV_EnableRxDMA(LPUART_Type *base, DMA_Type *dmaBase, uint8_t channel,
+                            uint8_t *buffer, size_t size, lpuart_rx_callback_t callback);
+
+/**
+ * @brief Hands the bytes received up to an idle line to the receive callback.
+ *
+ * Call this function from the LPUART interrupt handler. It does nothing unless the IDLE flag is set.
+ *
+ * @param base  LPUART peripheral base address.
+ */
+void LPUART_DRV_RxIdleIRQHandler(LPUART_Type *base);
+
+/**
+ * @brief Hands the bytes received up to a half or full buffer to the receive callback.
+ *
+ * Call this function from the interrupt handler of the DMA channel given to LPUART_DRV_EnableRxDMA().
+ *
+ * @param base  LPUART peripheral base address.
+ */
+void LPUART_DRV_RxDMAIRQHandler(LPUART_Type *base);
+
 #endif /* DRIVERS_DRIVER_UART_H_ */
 
 /******************************************************************************
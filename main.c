@@ -4,48 +4,104 @@
 #include "app_init.h"
 #include "encode.h"
 #include "queue.h"
+#include "parser.h"
+#include "dispatch.h"
+#include "scheduler.h"
+#include "sw_timer.h"
+#include "tickless.h"
+#include "profile.h"
+#include "trace.h"
+#include "input_event.h"
+#include "gesture.h"
+#include "adc_scan.h"
+#include "volume_filter.h"
+#include "ring_buffer.h"
 #include "driver_ftm.h"
 /******************************************************************************
  * Definitions
  ******************************************************************************/
-#define DOUBLE_CLICK_TIME   500
-#define ADC_RESOLUTION      4095
-#define ADC_UPDATE_DUR      200
+#if IRQ_PRIORITY_TICK != SW_TIMER_IRQ_PRIORITY
+#error "The tick work must run at the level masked by the timer wheel critical sections"
+#endif
+
 #define COLOUR_NUMBERS 		24
 #define LED_CHANGE_DUR		200
 
+/* Scheduler task ids, lower ids run first */
 typedef enum {
-    NONE,
-    SINGLE_CLICK,
-    DOUBLE_CLICK,
-    LONG_CLICK
-} ButtonState;
+    TASK_RX,        /* deferred command handlers */
+    TASK_BUTTON,    /* click detection */
+    TASK_ADC,       /* volume from the last ADC block or compare event */
+    TASK_TX,        /* frames for pending events */
+    TASK_LED,       /* next colour while playing */
+    TASK_DEBUG,     /* profile and trace dumps */
+} TaskId;
 
-ButtonState sw2State = NONE;
-ButtonState sw3State = NONE;
+/* Profile probe ids, one per handler and task */
+typedef enum {
+    PROBE_ISR_UART,
+    PROBE_ISR_DMA_TX,
+    PROBE_ISR_DMA_RX,
+    PROBE_ISR_PORTC,
+    PROBE_ISR_ADC,
+    PROBE_ISR_SYSTICK,
+    PROBE_ISR_LPIT,
+    PROBE_TASK_RX,
+    PROBE_TASK_BUTTON,
+    PROBE_TASK_ADC,
+    PROBE_TASK_TX,
+    PROBE_TASK_LED,
+} ProbeId;
 
 /******************************************************************************
  * Global variables
  ******************************************************************************/
 volatile char temp;
 
-volatile uint32_t tickCount          = 0;
-
-volatile uint8_t  checkSW2           = 0;
-volatile uint32_t firstSW2Press      = 0;
-volatile uint32_t pressSW2Count      = 0;
-
-volatile uint8_t  checkSW3           = 0;
-volatile uint32_t firstSW3Press      = 0;
-volatile uint32_t pressSW3Count      = 0;
-
 volatile uint8_t volume = 0;
-volatile uint32_t current_adc_value  = 0;
 
 volatile uint8_t  vol_flag           = 0;
 
 volatile uint8_t  playing_flag       = 0;
 
+/* Timing of the ADC trigger chain, as planned from the clocks */
+static adc_plan_t adcPlan;
+
+#if ADC_COMPARE_ENABLE
+/* Last result outside the compare window, written by ADC0_IRQHandler */
+static volatile uint16_t compareSample = 0;
+#endif
+
+/* Button gestures waiting for room in the TX ring, as option and value */
+RING_BUFFER_DEFINE(TX_EVENTS, uint8_t[2], 8U);
+
+/* Adding a button costs a row here and its pin set up in initGPIO() */
+static const gesture_button_t BUTTONS[] = {
+    {
+        .port = PORTC, .pin = SWITCH_2_PIN, .activeHigh = true,
+        .actions = {
+            [GESTURE_SINGLE] = { OPTION_UP,           MESSAGE_DEFAULT_VALUE },
+            [GESTURE_DOUBLE] = { OPTION_FORWARD,      MESSAGE_DEFAULT_VALUE },
+            [GESTURE_TRIPLE] = { OPTION_TRIPLE_CLICK, BUTTON_SW2_VALUE },
+            [GESTURE_LONG]   = { OPTION_LONG_PRESS,   BUTTON_SW2_VALUE },
+        },
+    },
+    {
+        .port = PORTC, .pin = SWITCH_3_PIN, .activeHigh = true,
+        .actions = {
+            [GESTURE_SINGLE] = { OPTION_CONFIRM,      MESSAGE_DEFAULT_VALUE },
+            [GESTURE_DOUBLE] = { OPTION_GO_BACK,      MESSAGE_DEFAULT_VALUE },
+            [GESTURE_TRIPLE] = { OPTION_TRIPLE_CLICK, BUTTON_SW3_VALUE },
+            [GESTURE_LONG]   = { OPTION_LONG_PRESS,   BUTTON_SW3_VALUE },
+        },
+    },
+};
+
+/* Deadlines, all driven by sw_timer_tick() in PendSV_Handler */
+static sw_timer_t ledTimer;
+static sw_timer_t txRetryTimer;
+static sw_timer_t debugRetryTimer;
+
 
 uint8_t colors[COLOUR_NUMBERS][3] = {
     {255, 0, 0},
@@ -81,122 +137,359 @@ uint8_t colors[COLOUR_NUMBERS][3] = {
 /******************************************************************************
  * Functions
  ******************************************************************************/
-static inline uint8_t adc_value_to_volume(uint32_t value)
+
+/* Gesture timeout or TX ring retry, the task does the rest */
+static void post_task(sw_timer_t* timer)
 {
-    return (uint8_t)(value * 100 / ADC_RESOLUTION + 1);
+    sched_post((uint8_t)(uintptr_t)timer->context);
 }
 
-static inline void Check_ADC()
+void change_colour();
+void turn_off_led();
+
+static void uart_rx_callback(const uint8_t *data, size_t length)
 {
-    static uint32_t update_time = ADC_UPDATE_DUR;
-    if(tickCount > update_time)
-    {   
-        update_time += ADC_UPDATE_DUR;
-        if(volume != adc_value_to_volume(current_adc_value))
+    while (0U != length)
+    {
+        TRACE(TRACE_RX_BYTE, *data, 0);
+        parser_put_byte(*data);
+        data++;
+        length--;
+    }
+    sched_post(TASK_RX);
+}
+
+static void post_button_task(void)
+{
+    sched_post(TASK_BUTTON);
+}
+
+static void on_gesture(uint8_t option, uint8_t value)
+{
+    uint8_t event[2] = { option, value };
+
+    /* A full ring drops the gesture, there is no one to wait for */
+    if (ring_buffer_push(&TX_EVENTS, event))
+    {
+        sched_post(TASK_TX);
+    }
+}
+
+static void on_playing(uint8_t option, uint8_t value)
+{
+    if (playing_flag == 0) {
+        playing_flag = 1;
+        change_colour();
+        sw_timer_start(&ledTimer, LED_CHANGE_DUR, LED_CHANGE_DUR);
+    }
+}
+
+static void on_pause(uint8_t option, uint8_t value)
+{
+    playing_flag = 0;
+    sw_timer_stop(&ledTimer);
+    turn_off_led();
+}
+
+static void on_protocol(uint8_t option, uint8_t value)
+{
+    switch (value)
+    {
+        case PROTOCOL_CMD_LEGACY:
+            encode_set_protocol(PROTOCOL_LEGACY);
+            encode_set_integrity(INTEGRITY_SUM8);
+            break;
+        case PROTOCOL_CMD_LEGACY_CRC8:
+            encode_set_protocol(PROTOCOL_LEGACY);
+            encode_set_integrity(INTEGRITY_CRC8);
+            break;
+        case PROTOCOL_CMD_V2:
+            encode_set_protocol(PROTOCOL_V2);
+            break;
+        default:
+            return;
+    }
+
+    /* The echo is the first frame in the new format */
+    (void)push_message(OPTION_PROTOCOL, value);
+    (void)flush_records();
+}
+
+static void task_rx()
+{
+    PROFILE_START();
+
+    dispatch_deferred();
+
+    PROFILE_STOP(PROBE_TASK_RX);
+}
+
+#if ADC_COMPARE_ENABLE
+/* After each result outside the compare window, the window is the hysteresis */
+static void task_adc()
+{
+    PROFILE_START();
+
+    uint8_t level = volume_filter_lookup(compareSample);
+
+    if (volume != level)
+    {
+        vol_flag = 1;
+        volume = level;
+        sched_post(TASK_TX);
+    }
+
+    PROFILE_STOP(PROBE_TASK_ADC);
+}
+#else
+static void post_adc_task(void)
+{
+    sched_post(TASK_ADC);
+}
+
+/* Every ADC_SCAN_BLOCK_FRAMES samples */
+static void task_adc()
+{
+    PROFILE_START();
+
+    const adc_scan_frame_t* block = adc_scan_get_block();
+    bool changed = false;
+    uint32_t index;
+
+    if (block != NULL)
+    {
+        /* Every sample goes through the filter, the volume is reported once per block */
+        for (index = 0; index < ADC_SCAN_BLOCK_FRAMES; index++)
+        {
+            changed |= volume_filter_put((uint16_t)block[index].samples[ADC_SCAN_VOLUME]);
+        }
+        TRACE(TRACE_ADC_SAMPLE, ADC_SCAN_VOLUME, volume_filter_get_smoothed());
+        if (changed)
         {
             vol_flag = 1;
-            volume = adc_value_to_volume(current_adc_value);
+            volume = volume_filter_get_volume();
+            sched_post(TASK_TX);
         }
     }
+
+    PROFILE_STOP(PROBE_TASK_ADC);
+}
+#endif
+
+static void task_button()
+{
+    PROFILE_START();
+
+    gesture_process();
+
+    PROFILE_STOP(PROBE_TASK_BUTTON);
 }
 
-static inline void Check_SW2()
+static void task_tx()
 {
-	static uint32_t preStateCount = 0;
-	uint32_t temp = pressSW2Count;
-	uint32_t count_diff = temp - preStateCount;
-    if(count_diff == 1 && checkSW2 == 0)
+    PROFILE_START();
+
+    const uint8_t* event;
+
+    /* Events stay pending until the TX ring accepts their frame */
+    while ((event = ring_buffer_peek(&TX_EVENTS)) != NULL)
+    {
+        if (!push_message(event[0], event[1]))
+        {
+            break;
+        }
+        ring_buffer_release(&TX_EVENTS);
+    }
+
+    if(vol_flag)
+    {
+        if (push_message(OPTION_VOLTAGE, volume))
+        {
+            vol_flag = 0;
+        }
+    }
+
+    /* Events pushed in this pass go out as one v2 frame, no-op for legacy frames */
+    (void)flush_records();
+
+    /* Try again on the next tick while the TX ring is full */
+    if (vol_flag || !ring_buffer_is_empty(&TX_EVENTS))
     {
-        firstSW2Press = tickCount;
-        checkSW2 = 1;
+        sw_timer_start(&txRetryTimer, 1, 0);
     }
-    else if(count_diff == 2)
+
+    PROFILE_STOP(PROBE_TASK_TX);
+}
+
+static void task_debug()
+{
+    bool done = true;
+
+    /* Continued on the next tick while the TX ring is full */
+#if PROFILE_ENABLE
+    done = profile_dump_step();
+#endif
+#if TRACE_ENABLE
+    done = done && trace_dump_step();
+#endif
+    if (!done)
     {
-        sw2State = DOUBLE_CLICK;
-        preStateCount = temp;
-        checkSW2 = 0;
+        sw_timer_start(&debugRetryTimer, 1, 0);
     }
-    else if((tickCount - firstSW2Press > DOUBLE_CLICK_TIME) && count_diff == 1)
+    (void)flush_records();
+}
+
+static void on_profile(uint8_t option, uint8_t value)
+{
+#if PROFILE_ENABLE
+    if (value == PROFILE_CMD_RESET)
     {
-        sw2State = SINGLE_CLICK;
-        preStateCount = temp;
-        checkSW2 = 0;
+        profile_reset();
     }
     else
     {
-        /* Nothing */
+        profile_dump_start();
+        sched_post(TASK_DEBUG);
     }
+#endif
 }
 
-static inline void Check_SW3()
+static void on_trace(uint8_t option, uint8_t value)
 {
-	static uint32_t preStateCount = 0;
-	uint32_t temp = pressSW3Count;
-	uint32_t count_diff = temp - preStateCount;
-	if(count_diff == 1 && checkSW3 == 0)
-	{
-		firstSW3Press = tickCount;
-		checkSW3 = 1;
-	}
-	else if(count_diff == 2)
-	{
-		sw3State = DOUBLE_CLICK;
-		preStateCount = temp;
-		checkSW3 = 0;
-	}
-	else if((tickCount - firstSW3Press > DOUBLE_CLICK_TIME) && count_diff == 1)
-	{
-		sw3State = SINGLE_CLICK;
-		preStateCount = temp;
-		checkSW3 = 0;
-	}
-	else
-	{
-		/* Nothing */
-	}
+#if TRACE_ENABLE
+    if (value == TRACE_CMD_CLEAR)
+    {
+        trace_clear();
+    }
+    else
+    {
+        trace_dump_start();
+        sched_post(TASK_DEBUG);
+    }
+#endif
 }
 
-void change_colour();
-void turn_off_led();
+static void task_led()
+{
+    PROFILE_START();
 
-static inline void Check_Playing() {
-    if (playing_flag == 0){
-    	turn_off_led();
-    } else if (tickCount % LED_CHANGE_DUR == 0 && playing_flag == 1) {
+    /* A pause may have been handled since the timer posted this run */
+    if (playing_flag == 1)
+    {
         change_colour();
     }
+
+    PROFILE_STOP(PROBE_TASK_LED);
 }
+
 /******************************************************************************
  * IRQ handlers
  ******************************************************************************/
 void LPUART1_RxTx_IRQHandler(void)
 {
+    PROFILE_START();
+
+#if UART_RX_DMA_ENABLE
+    LPUART_DRV_RxIdleIRQHandler(LPUART1);
+#else
 	if(LPUART1->STAT & LPUART_STAT_RDRF_MASK) {
-        queue_put_data(LPUART_DRV_ReadByte(LPUART1));
+        uint8_t data[LPUART_FIFO_SIZE_MAX];
+        uart_rx_callback(data, LPUART_DRV_ReadFifo(LPUART1, data, sizeof(data)));
 	}
+#endif
+	LPUART_DRV_TxIRQHandler(LPUART1);
+
+    PROFILE_STOP(PROBE_ISR_UART);
 }
 
-void PORTC_IRQHandler(void)
+void DMA1_IRQHandler(void)
 {
-    if (PORT_DRV_CheckPinInterruptFlags(PORTC, SWITCH_2_PIN))
-    {
-        PORT_DRV_ClearPinsInterruptFlags(PORTC, (1u << SWITCH_2_PIN));
-        pressSW2Count++;
-    }
-    else if (PORT_DRV_CheckPinInterruptFlags(PORTC, SWITCH_3_PIN))
-    {
-        PORT_DRV_ClearPinsInterruptFlags(PORTC, (1u << SWITCH_3_PIN));
-        pressSW3Count++;
-    }
-    else
+    PROFILE_START();
+
+    LPUART_DRV_TxDMAIRQHandler(LPUART1);
+    sched_post(TASK_TX);
+
+    PROFILE_STOP(PROBE_ISR_DMA_TX);
+}
+
+void DMA2_IRQHandler(void)
+{
+    PROFILE_START();
+
+    LPUART_DRV_RxDMAIRQHandler(LPUART1);
+
+    PROFILE_STOP(PROBE_ISR_DMA_RX);
+}
+
+#if ADC_COMPARE_ENABLE
+void ADC0_IRQHandler(void)
+{
+    PROFILE_START();
+
+    /* Reading the result clears COCO */
+    uint16_t sample = (uint16_t)ADC_DRV_GetChannelConversionValue(ADC0, ADC_SCAN_VOLUME);
+    adc_hardware_compare_config_t window =
     {
-        /* Nothing */
-    }
+        .mode   = ADC_HardwareCompareOutsideRange,
+        .value1 = (sample > ADC_COMPARE_WINDOW) ? (sample - ADC_COMPARE_WINDOW) : 0U,
+        .value2 = (sample < VOLUME_FILTER_INPUT_MAX - ADC_COMPARE_WINDOW) ?
+                  (sample + ADC_COMPARE_WINDOW) : VOLUME_FILTER_INPUT_MAX,
+    };
+
+    /* Re-centred, only the next move of the knob completes a conversion */
+    ADC_DRV_SetHardwareCompareConfig(ADC0, &window);
+    compareSample = sample;
+    /* Raw, in compare mode the window replaces the filter */
+    TRACE(TRACE_ADC_SAMPLE, ADC_SCAN_VOLUME, sample);
+    sched_post(TASK_ADC);
+
+    PROFILE_STOP(PROBE_ISR_ADC);
+}
+#else
+void DMA3_IRQHandler(void)
+{
+    PROFILE_START();
+
+    adc_scan_irq_handler();
+
+    PROFILE_STOP(PROBE_ISR_ADC);
+}
+#endif
+
+void LPIT0_Ch1_IRQHandler(void)
+{
+    PROFILE_START();
+
+    tickless_irq_handler();
+
+    PROFILE_STOP(PROBE_ISR_LPIT);
+}
+
+void PORTC_IRQHandler(void)
+{
+    PROFILE_START();
+
+    input_event_irq_handler(PORTC, PTC);
+
+    PROFILE_STOP(PROBE_ISR_PORTC);
 }
 
 void SysTick_Handler()
 {
-    tickCount++;
+    /* Nothing that reads the time base can preempt this, see SysTick_DRV_GetCycles() */
+    SysTick_DRV_IncTick();
+    S32_SCB->ICSR = S32_SCB_ICSR_PENDSVSET_MASK;
+}
+
+/* Tick work of the SysTick period, at the level the timer wheel critical sections mask */
+void PendSV_Handler()
+{
+    PROFILE_START();
+
+    sched_tick();
+    sw_timer_tick();
+
+    PROFILE_STOP(PROBE_ISR_SYSTICK);
 }
 
 /******************************************************************************
@@ -204,70 +497,63 @@ void SysTick_Handler()
  ******************************************************************************/
 int main(void)
 {
+#if PROFILE_ENABLE
+    (void)profile_init();
+#endif
+#if TRACE_ENABLE
+    trace_init();
+#endif
     initSCG();
     initGPIO();
-    initUART();
+    dispatch_register(OPTION_PLAYING, on_playing, DISPATCH_FLAG_DEFERRED);
+    dispatch_register(OPTION_PAUSE, on_pause, DISPATCH_FLAG_DEFERRED);
+    dispatch_register(OPTION_PROFILE, on_profile, DISPATCH_FLAG_DEFERRED);
+    dispatch_register(OPTION_TRACE, on_trace, DISPATCH_FLAG_DEFERRED);
+    dispatch_register(OPTION_PROTOCOL, on_protocol, DISPATCH_FLAG_DEFERRED);
+    initUART(uart_rx_callback);
     initADC();
     initLPIT();
-    initDMA((uint32_t)&current_adc_value);
-    initSIM();
+    volume_filter_init();
+#if !ADC_COMPARE_ENABLE
+    adc_scan_init(DMA, DMA_CHANNEL_ADC, DMA_CHANNEL_ADC_BLOCK, post_adc_task);
+    initDMA((uint32_t)adc_scan_ring());
+#endif
+    /* Started once the results have somewhere to go */
+    if (ADC_PLAN_OK != initTrigger(ADC_SAMPLE_RATE_HZ, &adcPlan))
+    {
+        /* LPIT or ADC0 clock not as initSCG() set it, no sampling */
+        assert(false);
+    }
     initFTM();
 
     SysTick_Config(SystemCoreClock/1000);
-    NVIC_EnableIRQ(SysTick_IRQn);
+    NVIC_SetPriority(SysTick_IRQn, IRQ_PRIORITY_SYSTICK);
+    NVIC_SetPriority(PendSV_IRQn, IRQ_PRIORITY_TICK);
 
-    while(1) {
-        Check_ADC();
-        Check_SW2();
-        Check_SW3();
+    sched_register(TASK_RX, task_rx);
+    sched_register(TASK_BUTTON, task_button);
+    sched_register(TASK_ADC, task_adc);
+    sched_register(TASK_TX, task_tx);
+    sched_register(TASK_LED, task_led);
+    sched_register(TASK_DEBUG, task_debug);
 
-        switch (sw2State)
-        {
-            case SINGLE_CLICK:
-                push_message(OPTION_UP, MESSAGE_DEFAULT_VALUE);
-                sw2State = NONE;
-                break;
-            case DOUBLE_CLICK:
-                push_message(OPTION_FORWARD, MESSAGE_DEFAULT_VALUE);
-                sw2State = NONE;
-                break;
-            default:
-                break;
-        }
-
-        switch (sw3State)
-        {
-            case SINGLE_CLICK:
-                push_message(OPTION_CONFIRM, MESSAGE_DEFAULT_VALUE);
-                sw3State = NONE;
-                break;
-            case DOUBLE_CLICK:
-                push_message(OPTION_GO_BACK, MESSAGE_DEFAULT_VALUE);
-                sw3State = NONE;
-                break;
-            default:
-                break;
-        }
+    sw_timer_init(&ledTimer, post_task, (void*)TASK_LED);
+    sw_timer_init(&txRetryTimer, post_task, (void*)TASK_TX);
+    sw_timer_init(&debugRetryTimer, post_task, (void*)TASK_DEBUG);
+    input_event_init(post_button_task);
+    gesture_init(BUTTONS, sizeof(BUTTONS) / sizeof(BUTTONS[0]), post_button_task, on_gesture);
+    turn_off_led();
 
-        if(vol_flag)
-        {
-            push_message(OPTION_VOLTAGE, volume);
-            vol_flag = 0;
-        }
+#if TICKLESS_IDLE_ENABLE
+    tickless_init(LPIT0, TICKLESS_LPIT_CHANNEL, CLOCK_DRV_GetIpFreq(CLOCK_LPIT));
+    NVIC_SetPriority(TICKLESS_LPIT_IRQn, IRQ_PRIORITY_TICK);
+    NVIC_EnableIRQ(TICKLESS_LPIT_IRQn);
+    sched_set_idle(tickless_idle);
+#endif
 
-        if (!is_queue_empty()) {
-            uint8_t* data = queue_get_data();
-//            if(checkReceiveCommandValid(data) == MESSAGE_CORRECT) {
-                if (data[MEASSAGE_OPTION_BYTE] == OPTION_PLAYING) {
-                    playing_flag = 1;
-                } else if (data[MEASSAGE_OPTION_BYTE] == OPTION_PAUSE){
-                    playing_flag = 0;
-                }
-//            }
-        }
+    /* Sleeps in WFI whenever no interrupt has posted work */
+    sched_run();
 
-        Check_Playing();
-    }
     return 0;
 }
 
@@ -276,11 +562,13 @@ void change_colour() {
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_0, (uint32_t)(colors[index][0] / 2.55));
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_1, (uint32_t)(colors[index][1] / 2.55));
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_2, (uint32_t)(colors[index][2] / 2.55));
+    TRACE(TRACE_LED_CHANGE, index, 0);
 	index++;
 	index = index % COLOUR_NUMBERS;
 }
 
 void turn_off_led() {
+    TRACE(TRACE_LED_CHANGE, 0xFF, 0);
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_0, 100);
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_1, 100);
     FTM_DRV_setDutyCycle(FTM0, FTM_Chnl_2, 100);
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "ring_buffer.h"
+
+/******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Copies count elements starting at index in, splitting the copy at the wrap */
+static void ring_buffer_copy_in(ring_buffer_t *ring, uint32_t index,
+                                const uint8_t *src, uint32_t count)
+{
+    uint32_t offset = index & ring->mask;
+    uint32_t first  = ring_buffer_capacity(ring) - offset;
+
+    if (first > count)
+    {
+        first = count;
+    }
+    memcpy(&ring->storage[offset * ring->elementSize], src, first * ring->elementSize);
+    memcpy(ring->storage, &src[first * ring->elementSize], (count - first) * ring->elementSize);
+}
+
+/* Copies count elements out starting at index, splitting the copy at the wrap */
+static void ring_buffer_copy_out(const ring_buffer_t *ring, uint32_t index,
+                                 uint8_t *dst, uint32_t count)
+{
+    uint32_t offset = index & ring->mask;
+    uint32_t first  = ring_buffer_capacity(ring) - offset;
+
+    if (first > count)
+    {
+        first = count;
+    }
+    memcpy(dst, &ring->storage[offset * ring->elementSize], first * ring->elementSize);
+    memcpy(&dst[first * ring->elementSize], ring->storage, (count - first) * ring->elementSize);
+}
+
+void ring_buffer_init(ring_buffer_t *ring, void *storage, uint32_t elementSize, uint32_t capacity)
+{
+    assert(NULL != ring);
+    assert(NULL != storage);
+    assert(0U < elementSize);
+    assert((0U < capacity) && (0U == (capacity & (capacity - 1U))));
+
+    ring->storage     = (uint8_t *)storage;
+    ring->elementSize = elementSize;
+    ring->mask        = capacity - 1U;
+    ring->head        = 0U;
+    ring->tail        = 0U;
+}
+
+bool ring_buffer_push(ring_buffer_t *ring, const void *element)
+{
+    return 1U == ring_buffer_push_batch(ring, element, 1U);
+}
+
+bool ring_buffer_pop(ring_buffer_t *ring, void *element)
+{
+    return 1U == ring_buffer_pop_batch(ring, element, 1U);
+}
+
+uint32_t ring_buffer_push_batch(ring_buffer_t *ring, const void *elements, uint32_t count)
+{
+    uint32_t head = ring->head;
+    uint32_t room = ring_buffer_capacity(ring) - (head - ring->tail);
+
+    if (count > room)
+    {
+        count = room;
+    }
+    if (0U == count)
+    {
+        return 0U;
+    }
+
+    ring_buffer_copy_in(ring, head, (const uint8_t *)elements, count);
+    /* Elements must be visible before the consumer sees the new head */
+    __DMB();
+    ring->head = head + count;
+
+    return count;
+}
+
+uint32_t ring_buffer_pop_batch(ring_buffer_t *ring, void *elements, uint32_t count)
+{
+    uint32_t tail      = ring->tail;
+    uint32_t available = ring->head - tail;
+
+    if (count > available)
+    {
+        count = available;
+    }
+    if (0U == count)
+    {
+        return 0U;
+    }
+
+    /* Do not read the slots before the head that published them */
+    __DMB();
+    ring_buffer_copy_out(ring, tail, (uint8_t *)elements, count);
+    /* Slots must be read before the producer may reuse them */
+    __DMB();
+    ring->tail = tail + count;
+
+    return count;
+}
+
+void *ring_buffer_peek(ring_buffer_t *ring)
+{
+    uint32_t tail = ring->tail;
+
+    if (ring->head == tail)
+    {
+        return NULL;
+    }
+
+    /* Do not read the slot before the head that published it */
+    __DMB();
+
+    return &ring->storage[(tail & ring->mask) * ring->elementSize];
+}
+
+void ring_buffer_release(ring_buffer_t *ring)
+{
+    assert(!ring_buffer_is_empty(ring));
+
+    /* The consumer must be done with the slot before the producer may reuse it */
+    __DMB();
+    ring->tail = ring->tail + 1U;
+}
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/
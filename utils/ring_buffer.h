@@ -0,0 +1,173 @@
+#ifndef UTILS_RING_BUFFER_H_
+#define UTILS_RING_BUFFER_H_
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "driver_common.h"
+
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * @brief Single-producer/single-consumer ring of fixed-size elements.
+ *
+ * head and tail run freely and are masked on access, so all slots are usable and
+ * no separate full flag is needed. Only the producer writes head and only the
+ * consumer writes tail; each side publishes its index after a DMB, so the ring can
+ * be shared between one interrupt and the main loop without a critical section.
+ */
+typedef struct _ring_buffer
+{
+    uint8_t *storage;           /* capacity * elementSize bytes */
+    uint32_t elementSize;       /* Size of one element in bytes */
+    uint32_t mask;              /* capacity - 1, capacity is a power of two */
+    volatile uint32_t head;     /* Elements pushed so far, written by the producer only */
+    volatile uint32_t tail;     /* Elements popped so far, written by the consumer only */
+} ring_buffer_t;
+
+/**
+ * @brief Defines a static ring and its storage.
+ *
+ * @param name   Name of the ring_buffer_t variable.
+ * @param type   Element type.
+ * @param depth  Number of elements, must be a power of two.
+ */
+#define RING_BUFFER_DEFINE(name, type, depth)                                          \
+    typedef char name##_depth_is_power_of_two[(((depth) & ((depth) - 1U)) == 0U) ? 1 : -1]; \
+    static uint8_t name##_storage[(depth) * sizeof(type)] __attribute__((aligned(4)));  \
+    static ring_buffer_t name = { .storage     = name##_storage,                       \
+                                  .elementSize = sizeof(type),                         \
+                                  .mask        = (depth) - 1U,                         \
+                                  .head        = 0U,                                   \
+                                  .tail        = 0U }
+
+/******************************************************************************
+ * API
+ ******************************************************************************/
+/**
+ * @brief Initializes a ring over caller-provided storage.
+ *
+ * @param ring         Ring to initialize.
+ * @param storage      capacity * elementSize bytes of storage.
+ * @param elementSize  Size of one element in bytes.
+ * @param capacity     Number of elements, must be a power of two.
+ */
+void ring_buffer_init(ring_buffer_t *ring, void *storage, uint32_t elementSize, uint32_t capacity);
+
+/**
+ * @brief Gets the number of elements the ring can hold.
+ *
+ * @param ring  Ring buffer.
+ * @return Capacity in elements.
+ */
+static inline uint32_t ring_buffer_capacity(const ring_buffer_t *ring)
+{
+    return ring->mask + 1U;
+}
+
+/**
+ * @brief Gets the number of elements waiting in the ring.
+ *
+ * @param ring  Ring buffer.
+ * @return Number of queued elements.
+ */
+static inline uint32_t ring_buffer_count(const ring_buffer_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+/**
+ * @brief Gets the number of free slots.
+ *
+ * @param ring  Ring buffer.
+ * @return Number of elements that can be pushed.
+ */
+static inline uint32_t ring_buffer_free(const ring_buffer_t *ring)
+{
+    return ring_buffer_capacity(ring) - ring_buffer_count(ring);
+}
+
+/**
+ * @brief Checks if the ring is empty.
+ *
+ * @param ring  Ring buffer.
+ * @return true if there is nothing to pop.
+ */
+static inline bool ring_buffer_is_empty(const ring_buffer_t *ring)
+{
+    return ring->head == ring->tail;
+}
+
+/**
+ * @brief Checks if the ring is full.
+ *
+ * @param ring  Ring buffer.
+ * @return true if there is no room to push.
+ */
+static inline bool ring_buffer_is_full(const ring_buffer_t *ring)
+{
+    return ring_buffer_count(ring) > ring->mask;
+}
+
+/**
+ * @brief Pushes one element. Producer side only.
+ *
+ * @param ring     Ring buffer.
+ * @param element  Element to copy in.
+ * @return true if pushed, false if the ring is full.
+ */
+bool ring_buffer_push(ring_buffer_t *ring, const void *element);
+
+/**
+ * @brief Pops one element. Consumer side only.
+ *
+ * @param ring     Ring buffer.
+ * @param element  Where to copy the element out.
+ * @return true if popped, false if the ring is empty.
+ */
+bool ring_buffer_pop(ring_buffer_t *ring, void *element);
+
+/**
+ * @brief Pushes up to count consecutive elements. Producer side only.
+ *
+ * @param ring      Ring buffer.
+ * @param elements  Elements to copy in.
+ * @param count     Number of elements offered.
+ * @return Number of elements pushed, limited by the free space.
+ */
+uint32_t ring_buffer_push_batch(ring_buffer_t *ring, const void *elements, uint32_t count);
+
+/**
+ * @brief Pops up to count elements. Consumer side only.
+ *
+ * @param ring      Ring buffer.
+ * @param elements  Where to copy the elements out.
+ * @param count     Number of elements wanted.
+ * @return Number of elements popped, limited by what is queued.
+ */
+uint32_t ring_buffer_pop_batch(ring_buffer_t *ring, void *elements, uint32_t count);
+
+/**
+ * @brief Lends the oldest element in place. Consumer side only.
+ *
+ * The slot stays owned by the consumer, the producer cannot overwrite it until
+ * ring_buffer_release() is called.
+ *
+ * @param ring  Ring buffer.
+ * @return Pointer to the oldest element, NULL if the ring is empty.
+ */
+void *ring_buffer_peek(ring_buffer_t *ring);
+
+/**
+ * @brief Gives the element lent by ring_buffer_peek() back to the producer. Consumer side only.
+ *
+ * @param ring  Ring buffer, must not be empty.
+ */
+void ring_buffer_release(ring_buffer_t *ring);
+
+#endif /* UTILS_RING_BUFFER_H_ */
+
+/******************************************************************************
+ * EOF
+ ******************************************************************************/